@@ -0,0 +1,243 @@
+/*!
+ * @brief A small benchmark harness. Every benchmark is run for a number
+ * of untimed warmup samples, then timed over a fixed number of samples,
+ * and summarised with order statistics so a single outlier can't move
+ * the result the way it moves a mean.
+ */
+
+#ifndef PROJEKT_BENCHMARK_H
+#define PROJEKT_BENCHMARK_H
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+struct benchmark_settings
+{
+    uint32_t warmup = 10;
+    uint32_t repetitions = 100;
+
+    /*
+     * Only benchmarks whose name contains the filter are run.
+     */
+    std::string filter;
+};
+
+struct benchmark
+{
+    std::string name;
+
+    /*
+     * Operations per sample, for operations too short to be timed one at a time.
+     */
+    uint32_t batch_size = 1;
+
+    /*
+     * setup and teardown run once around the benchmark, before_sample before every sample,
+     * none of them timed. All three are optional.
+     */
+    std::function<void( )> setup;
+    std::function<void( )> teardown;
+    std::function<void( )> before_sample;
+
+    std::function<void( )> run;
+
+    /*
+     * Replaces the wall time of a sample, in milliseconds, when only part of run is of interest.
+     */
+    std::function<double( )> measure;
+};
+
+struct benchmark_result
+{
+    std::string name;
+    uint32_t batch_size = 1;
+
+    /*
+     * All in microseconds per operation.
+     */
+    double min = 0.0;
+    double mean = 0.0;
+    double stddev = 0.0;
+    double p50 = 0.0;
+    double p95 = 0.0;
+    double p99 = 0.0;
+    double max = 0.0;
+
+    std::vector<double> samples;
+};
+
+class benchmark_runner
+{
+public:
+    using clock = std::chrono::steady_clock;
+
+public:
+    explicit benchmark_runner( const benchmark_settings& settings )
+        :
+        settings_( settings )
+    {
+    }
+
+    void add( benchmark&& benchmark )
+    {
+        benchmarks_.emplace_back( std::move( benchmark ) );
+    }
+
+    const std::vector<benchmark_result>& run( std::ostream& log )
+    {
+        results_.clear();
+
+        for( auto& benchmark : benchmarks_ )
+        {
+            if( !settings_.filter.empty() && benchmark.name.find( settings_.filter ) == std::string::npos )
+                continue;
+
+            log << "Running " << benchmark.name << "..." << std::endl;
+
+            results_.emplace_back( run( benchmark ) );
+        }
+
+        return results_;
+    }
+
+    void print( std::ostream& out ) const
+    {
+        out << std::left << std::setw( 40 ) << "benchmark" << std::right
+            << std::setw( 12 ) << "min us" << std::setw( 12 ) << "p50 us" << std::setw( 12 ) << "p95 us"
+            << std::setw( 12 ) << "p99 us" << std::setw( 12 ) << "max us" << std::setw( 12 ) << "stddev" << std::endl;
+
+        out << std::fixed << std::setprecision( 3 );
+        for( const auto& result : results_ )
+        {
+            out << std::left << std::setw( 40 ) << result.name << std::right
+                << std::setw( 12 ) << result.min << std::setw( 12 ) << result.p50 << std::setw( 12 ) << result.p95
+                << std::setw( 12 ) << result.p99 << std::setw( 12 ) << result.max << std::setw( 12 ) << result.stddev << std::endl;
+        }
+    }
+
+    /*
+     * environment is written as is, it should describe everything a result depends on.
+     */
+    std::string to_json( const std::vector<std::pair<std::string, std::string>>& environment ) const
+    {
+        std::ostringstream json;
+        json << std::fixed << std::setprecision( 3 );
+
+        json << "{\"environment\":{";
+        for( size_t i = 0; i < environment.size(); ++i )
+            json << ( i == 0 ? "" : "," ) << "\"" << environment[i].first << "\":\"" << environment[i].second << "\"";
+
+        json << "},\"warmup\":" << settings_.warmup << ",\"repetitions\":" << settings_.repetitions
+             << ",\"unit\":\"us\",\"benchmarks\":[";
+
+        for( size_t i = 0; i < results_.size(); ++i )
+        {
+            const auto& result = results_[i];
+
+            json << ( i == 0 ? "" : "," )
+                 << "{\"name\":\"" << result.name << "\",\"batch_size\":" << result.batch_size
+                 << ",\"min\":" << result.min << ",\"mean\":" << result.mean << ",\"stddev\":" << result.stddev
+                 << ",\"p50\":" << result.p50 << ",\"p95\":" << result.p95 << ",\"p99\":" << result.p99
+                 << ",\"max\":" << result.max << ",\"samples\":[";
+
+            for( size_t j = 0; j < result.samples.size(); ++j )
+                json << ( j == 0 ? "" : "," ) << result.samples[j];
+
+            json << "]}";
+        }
+
+        json << "]}";
+
+        return json.str();
+    }
+
+private:
+    benchmark_result run( benchmark& benchmark )
+    {
+        if( benchmark.setup )
+            benchmark.setup( );
+
+        benchmark_result result = {};
+        result.name = benchmark.name;
+        result.batch_size = benchmark.batch_size;
+        result.samples.reserve( settings_.repetitions );
+
+        for( uint32_t i = 0; i < settings_.warmup + settings_.repetitions; ++i )
+        {
+            if( benchmark.before_sample )
+                benchmark.before_sample( );
+
+            const auto start = clock::now( );
+
+            for( uint32_t j = 0; j < benchmark.batch_size; ++j )
+                benchmark.run( );
+
+            const auto end = clock::now( );
+
+            if( i < settings_.warmup )
+                continue;
+
+            double sample = benchmark.measure ? benchmark.measure( ) * 1000.0
+                                              : std::chrono::duration<double, std::micro>( end - start ).count();
+
+            result.samples.push_back( sample / benchmark.batch_size );
+        }
+
+        if( benchmark.teardown )
+            benchmark.teardown( );
+
+        summarise( result );
+
+        return result;
+    }
+
+    static void summarise( benchmark_result& result )
+    {
+        if( result.samples.empty() )
+            return;
+
+        auto sorted = result.samples;
+        std::sort( sorted.begin(), sorted.end() );
+
+        auto rank = [&sorted]( double p )
+        {
+            auto i = static_cast<size_t>( std::ceil( p * sorted.size() ) );
+            return sorted[std::max<size_t>( i, 1 ) - 1];
+        };
+
+        result.min = sorted.front();
+        result.max = sorted.back();
+        result.p50 = rank( 0.50 );
+        result.p95 = rank( 0.95 );
+        result.p99 = rank( 0.99 );
+
+        double sum = 0.0;
+        for( auto sample : sorted )
+            sum += sample;
+
+        result.mean = sum / sorted.size();
+
+        double squared_sum = 0.0;
+        for( auto sample : sorted )
+            squared_sum += ( sample - result.mean ) * ( sample - result.mean );
+
+        result.stddev = sorted.size() > 1 ? std::sqrt( squared_sum / ( sorted.size() - 1 ) ) : 0.0;
+    }
+
+private:
+    benchmark_settings settings_;
+
+    std::vector<benchmark> benchmarks_;
+    std::vector<benchmark_result> results_;
+};
+
+#endif //PROJEKT_BENCHMARK_H
@@ -0,0 +1,422 @@
+/*!
+ * @brief Microbenchmarks for the engine's hot paths. The renderer runs
+ * headless, so any device works, including software ones such as
+ * lavapipe. Swapchain recreation needs a surface and is only run with
+ * --windowed. Shaders are loaded from <data-dir>/shaders, the build
+ * directory by default. A single headless frame is read back and checked
+ * before any benchmark runs, a mismatch fails the run.
+ *
+ * Usage: projekt_bench [--filter name] [--warmup n] [--repetitions n]
+ *                      [--output file] [--data-dir dir] [--windowed]
+ */
+
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "../engine/graphics/renderer.h"
+#include "../engine/utils/exception/exception.h"
+#include "../engine/utils/exception/vulkan_exception.h"
+#include "../engine/utils/file_io/read.h"
+#include "../engine/utils/file_io/write.h"
+#include "../engine/utils/profiling/cpu_profiler.h"
+#include "../engine/window/event/event_handler.h"
+#include "../engine/window/window.h"
+
+#include "benchmark.h"
+
+constexpr const uint32_t WIDTH = 1280;
+constexpr const uint32_t HEIGHT = 720;
+constexpr const uint32_t GRID_SIZE = 64;
+constexpr const uint32_t DRAW_COUNT = 64;
+constexpr const uint32_t EVENT_COUNT = 64;
+constexpr const uint32_t UNIFORM_UPDATE_COUNT = 128;
+constexpr const uint32_t OBJECT_COUNT = 4096;
+constexpr const float OBJECT_SPACING = 0.25f;
+
+struct options
+{
+    benchmark_settings settings;
+
+    std::string output = "bench_results.json";
+    std::string data_dir = ".";
+    bool is_windowed = false;
+};
+
+static options
+parse_options( int argc, char** argv )
+{
+    options result;
+
+    for( int i = 1; i < argc; ++i )
+    {
+        const std::string arg = argv[i];
+        const bool has_value = i + 1 < argc;
+
+        if( arg == "--filter" && has_value )
+            result.settings.filter = argv[++i];
+        else if( arg == "--warmup" && has_value )
+            result.settings.warmup = static_cast<uint32_t>( std::stoul( argv[++i] ) );
+        else if( arg == "--repetitions" && has_value )
+            result.settings.repetitions = static_cast<uint32_t>( std::stoul( argv[++i] ) );
+        else if( arg == "--output" && has_value )
+            result.output = argv[++i];
+        else if( arg == "--data-dir" && has_value )
+            result.data_dir = argv[++i];
+        else if( arg == "--windowed" )
+            result.is_windowed = true;
+        else
+            throw exception{ "Unknown or incomplete argument: " + arg + ".", __FILE__, __LINE__ };
+    }
+
+    return result;
+}
+
+/*
+ * The same mesh on every run, so buffer sizes never vary between results.
+ */
+static void
+make_grid( std::vector<vk::graphics::vertex>& vertices, std::vector<std::uint16_t>& indices )
+{
+    vertices.clear();
+    indices.clear();
+
+    for( uint32_t y = 0; y < GRID_SIZE; ++y )
+    {
+        for( uint32_t x = 0; x < GRID_SIZE; ++x )
+        {
+            const float u = static_cast<float>( x ) / ( GRID_SIZE - 1 );
+            const float v = static_cast<float>( y ) / ( GRID_SIZE - 1 );
+
+            vertices.push_back( { { u * 2.0f - 1.0f, v * 2.0f - 1.0f, 1.0f }, { u, v, 1.0f - u } } );
+        }
+    }
+
+    for( uint32_t y = 0; y + 1 < GRID_SIZE; ++y )
+    {
+        for( uint32_t x = 0; x + 1 < GRID_SIZE; ++x )
+        {
+            const auto i = static_cast<std::uint16_t>( y * GRID_SIZE + x );
+
+            indices.insert( indices.end(), { i, static_cast<std::uint16_t>( i + 1 ), static_cast<std::uint16_t>( i + GRID_SIZE ),
+                                             static_cast<std::uint16_t>( i + 1 ), static_cast<std::uint16_t>( i + GRID_SIZE + 1 ),
+                                             static_cast<std::uint16_t>( i + GRID_SIZE ) } );
+        }
+    }
+}
+
+/*
+ * A grid twice as wide as the view, so roughly three quarters of it is culled.
+ */
+static std::vector<vk::graphics::object_data>
+make_objects( uint32_t index_count )
+{
+    const auto side = static_cast<uint32_t>( std::ceil( std::sqrt( static_cast<float>( OBJECT_COUNT ) ) ) );
+    const auto half_extent = ( side - 1 ) * OBJECT_SPACING * 0.5f;
+
+    std::vector<vk::graphics::object_data> objects( OBJECT_COUNT );
+    for( uint32_t i = 0; i < OBJECT_COUNT; ++i )
+    {
+        const auto position = glm::vec3( ( i % side ) * OBJECT_SPACING - half_extent, ( i / side ) * OBJECT_SPACING - half_extent, 0.0f );
+
+        auto& object = objects[i];
+        object.model = glm::scale( glm::translate( glm::mat4( 1.0f ), position ), glm::vec3( 0.1f ) );
+        object.bounding_sphere = glm::vec4( 0.0f, 0.0f, 1.0f, std::sqrt( 2.0f ) );
+        object.index_count = index_count;
+        object.first_index = 0;
+        object.vertex_offset = 0;
+    }
+
+    return objects;
+}
+
+static bool
+file_exists( const std::string& path )
+{
+    return std::ifstream( path ).good();
+}
+
+static void
+update_uniforms( renderer& renderer )
+{
+    auto model_matrix = glm::mat4( 1.0f );
+    auto view_matrix = glm::lookAt( glm::vec3( 0.0f, 0.0f, 5.0f ), glm::vec3( 0.0f, 0.0f, 0.0f ), glm::vec3( 0.0f, 1.0f, 0.0f ) );
+    auto projection_matrix = glm::perspective( glm::radians( 90.0f ), WIDTH / static_cast<float>( HEIGHT ), 0.1f, 10.0f );
+
+    renderer.update( model_matrix, view_matrix, projection_matrix );
+}
+
+static void
+render_frame( renderer& renderer, uint32_t index_count, uint32_t draw_count = DRAW_COUNT )
+{
+    renderer.prepare_frame( );
+
+    update_uniforms( renderer );
+
+    vk::graphics::draw_call draw_call = {};
+    draw_call.index_count = index_count;
+
+    for( uint32_t i = 0; i < draw_count; ++i )
+        renderer.draw( draw_call );
+
+    renderer.submit_frame( );
+
+    cpu_profiler::end_frame( );
+}
+
+/*
+ * The grid covers the middle of the view and leaves the corners at the clear colour.
+ */
+static void
+check_readback( renderer& renderer, uint32_t index_count )
+{
+    renderer.request_readback( );
+    render_frame( renderer, index_count, 1 );
+
+    std::vector<uint8_t> pixels;
+    if( !renderer.read_back( pixels ) )
+        throw exception{ "Readback check: no frame was read back.", __FILE__, __LINE__ };
+
+    if( pixels.size() < static_cast<size_t>( WIDTH ) * HEIGHT * 4 )
+        throw exception{ "Readback check: the readback is smaller than the target.", __FILE__, __LINE__ };
+
+    auto pixel_at = [&pixels]( uint32_t x, uint32_t y )
+    {
+        return &pixels[( static_cast<size_t>( y ) * WIDTH + x ) * 4];
+    };
+
+    const auto* p_corner = pixel_at( 0, 0 );
+    if( p_corner[0] != 0 || p_corner[1] != 0 || p_corner[2] != 0 || p_corner[3] != 255 )
+        throw exception{ "Readback check: the corner is not the clear colour.", __FILE__, __LINE__ };
+
+    const auto* p_centre = pixel_at( WIDTH / 2, HEIGHT / 2 );
+    if( p_centre[0] == 0 && p_centre[1] == 0 && p_centre[2] == 0 )
+        throw exception{ "Readback check: nothing was drawn at the centre.", __FILE__, __LINE__ };
+
+    if( renderer.read_back( pixels ) )
+        throw exception{ "Readback check: the same request was read back twice.", __FILE__, __LINE__ };
+
+    std::cout << "Readback check passed." << std::endl;
+}
+
+/*
+ * Time spent in the named zone during the last profiled frame, in milliseconds.
+ */
+static double
+get_zone_time( const char* name )
+{
+    double duration = 0.0;
+
+    for( const auto& zone : cpu_profiler::get_zones() )
+    {
+        if( std::strcmp( zone.name, name ) == 0 )
+            duration += zone.duration;
+    }
+
+    return duration;
+}
+
+int main( int argc, char** argv )
+{
+    try
+    {
+        const auto options = parse_options( argc, argv );
+
+        const auto vertex_shader_path = options.data_dir + "/shaders/vert.spv";
+        const auto fragment_shader_path = options.data_dir + "/shaders/frag.spv";
+        const auto indirect_shader_path = options.data_dir + "/shaders/indirect_vert.spv";
+        const auto cull_shader_path = options.data_dir + "/shaders/cull.spv";
+
+        std::vector<vk::graphics::vertex> vertices;
+        std::vector<std::uint16_t> indices;
+        make_grid( vertices, indices );
+
+        const auto index_count = static_cast<uint32_t>( indices.size() );
+
+        renderer headless_renderer( WIDTH, HEIGHT );
+        headless_renderer.create_pipeline( std::string( vertex_shader_path ), std::string( fragment_shader_path ) );
+        headless_renderer.prepare_for_rendering( vertices, indices );
+
+        check_readback( headless_renderer, index_count );
+
+        std::unique_ptr<window> p_window;
+        std::unique_ptr<renderer> p_windowed_renderer;
+        if( options.is_windowed )
+        {
+            p_window = std::make_unique<window>( WIDTH, HEIGHT, "Projekt - bench" );
+            p_windowed_renderer = std::make_unique<renderer>( *p_window );
+            p_windowed_renderer->create_pipeline( std::string( vertex_shader_path ), std::string( fragment_shader_path ) );
+            p_windowed_renderer->prepare_for_rendering( vertices, indices );
+        }
+
+        benchmark_runner runner( options.settings );
+
+        std::vector<event> events;
+
+        {
+            benchmark b;
+            b.name = "file/read_from_binary_file";
+            b.batch_size = 10;
+            b.run = [&vertex_shader_path]{ read_from_binary_file( vertex_shader_path ); };
+
+            runner.add( std::move( b ) );
+        }
+        {
+            benchmark b;
+            b.name = "event/push_pull_" + std::to_string( EVENT_COUNT );
+            b.batch_size = 100;
+            b.setup = [&events]{ events.reserve( event_handler::EVENT_QUEUE_CAPACITY ); };
+            b.run = [&events]
+            {
+                event e = {};
+                e.event_type = event::type::key_pressed;
+                e.key.key = io::keyboard::key::space;
+
+                for( uint32_t i = 0; i < EVENT_COUNT; ++i )
+                    event_handler::push_event( e );
+
+                event_handler::pull( events );
+            };
+
+            runner.add( std::move( b ) );
+        }
+        {
+            /*
+             * A frame between samples lets the deletion queue free the buffers retired by the last one.
+             */
+            benchmark b;
+            b.name = "buffer/set_mesh_" + std::to_string( GRID_SIZE * GRID_SIZE );
+            b.before_sample = [&]{ render_frame( headless_renderer, index_count ); };
+            b.run = [&]{ headless_renderer.set_mesh( vertices, indices ); };
+
+            runner.add( std::move( b ) );
+        }
+        {
+            /*
+             * prepare_frame rewinds the frame's uniform slice, which only has room for so many updates.
+             */
+            benchmark b;
+            b.name = "uniform/update";
+            b.batch_size = UNIFORM_UPDATE_COUNT;
+            b.before_sample = [&]{ headless_renderer.prepare_frame( ); };
+            b.run = [&]{ update_uniforms( headless_renderer ); };
+
+            runner.add( std::move( b ) );
+        }
+        {
+            benchmark b;
+            b.name = "frame/headless_" + std::to_string( DRAW_COUNT ) + "_draws";
+            b.run = [&]{ render_frame( headless_renderer, index_count ); };
+
+            runner.add( std::move( b ) );
+        }
+        {
+            benchmark b;
+            b.name = "frame/record_commands_" + std::to_string( DRAW_COUNT ) + "_draws";
+            b.run = [&]{ render_frame( headless_renderer, index_count ); };
+            b.measure = []{ return get_zone_time( "record commands" ); };
+
+            runner.add( std::move( b ) );
+        }
+        {
+            /*
+             * The builder hands back the pipeline it already has for the same SPIR-V, so this times
+             * reading the shaders and the cache lookup rather than a compilation.
+             */
+            benchmark b;
+            b.name = "pipeline/create_pipeline_cached";
+            b.before_sample = [&]{ render_frame( headless_renderer, index_count ); };
+            b.run = [&]
+            {
+                headless_renderer.create_pipeline( std::string( vertex_shader_path ), std::string( fragment_shader_path ) );
+            };
+
+            runner.add( std::move( b ) );
+        }
+
+        if( !headless_renderer.is_gpu_driven_supported( ) )
+        {
+            std::cout << "Skipping frame/gpu_driven: the device lacks drawIndirectFirstInstance." << std::endl;
+        }
+        else if( !file_exists( indirect_shader_path ) || !file_exists( cull_shader_path ) )
+        {
+            std::cout << "Skipping frame/gpu_driven: " << cull_shader_path << " or " << indirect_shader_path
+                      << " is missing, build the shaders first." << std::endl;
+        }
+        else
+        {
+            /*
+             * Added after every other headless case, since once the renderer is GPU driven every frame culls.
+             */
+            benchmark b;
+            b.name = "frame/gpu_driven_" + std::to_string( OBJECT_COUNT ) + "_objects";
+            b.setup = [&]
+            {
+                headless_renderer.prepare_gpu_driven_rendering( std::string( indirect_shader_path ), std::string( cull_shader_path ), OBJECT_COUNT );
+                headless_renderer.set_objects( make_objects( index_count ) );
+            };
+            b.run = [&]{ render_frame( headless_renderer, index_count, 0 ); };
+
+            runner.add( std::move( b ) );
+        }
+
+        if( p_windowed_renderer )
+        {
+            /*
+             * Alternating the image count forces a rebuild on every frame.
+             */
+            benchmark b;
+            b.name = "swapchain/recreate";
+            b.run = [&, image_count = 2u]() mutable
+            {
+                image_count = image_count == 2 ? 3 : 2;
+
+                p_windowed_renderer->set_swapchain_image_count( image_count );
+                render_frame( *p_windowed_renderer, index_count );
+            };
+            b.measure = []{ return get_zone_time( "recreate swapchain" ); };
+
+            runner.add( std::move( b ) );
+        }
+
+        runner.run( std::cout );
+        runner.print( std::cout );
+
+        const auto& properties = headless_renderer.get_device_properties();
+
+        write_to_file( options.output, runner.to_json( {
+            { "device", properties.deviceName },
+            { "driver_version", std::to_string( properties.driverVersion ) },
+            { "api_version", std::to_string( VK_VERSION_MAJOR( properties.apiVersion ) ) + "." +
+                             std::to_string( VK_VERSION_MINOR( properties.apiVersion ) ) + "." +
+                             std::to_string( VK_VERSION_PATCH( properties.apiVersion ) ) },
+            { "validation", enable_validation_layers ? "on" : "off" },
+            { "frames_in_flight", std::to_string( headless_renderer.get_frames_in_flight() ) },
+            { "extent", std::to_string( WIDTH ) + "x" + std::to_string( HEIGHT ) }
+        } ) );
+
+        std::cout << "Results written to " << options.output << std::endl;
+    }
+    catch( vulkan_exception& e )
+    {
+        std::cerr << "vulkan exception: " << e.what() << " (" << e.get_file() << ":" << e.get_line() << ")" << std::endl;
+        return 1;
+    }
+    catch( exception& e )
+    {
+        std::cerr << "engine exception: " << e.what() << " (" << e.get_file() << ":" << e.get_line() << ")" << std::endl;
+        return 1;
+    }
+    catch( std::exception& e )
+    {
+        std::cerr << "STL exception: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -2,6 +2,7 @@
  *
  */
 
+#include <chrono>
 #include <cstring>
 #include <iostream>
 #include <set>
@@ -13,210 +14,904 @@
 
 #include "../vulkan/helpers/queue_family_indices.h"
 
+#include "../utils/exception/exception.h"
 #include "../utils/exception/vulkan_exception.h"
 #include "../utils/file_io/read.h"
+#include "../utils/profiling/cpu_profiler.h"
 #include "../vulkan/graphics/uniform_buffer_object.h"
 
-constexpr const int MAX_FRAMES_IN_FLIGHT = 2;
+constexpr const uint32_t MIN_FRAMES_IN_FLIGHT = 1;
+constexpr const uint32_t MAX_FRAMES_IN_FLIGHT = 4;
+constexpr const char* PIPELINE_CACHE_PATH = "pipeline_cache.bin";
+constexpr const VkDeviceSize UNIFORM_FRAME_SIZE = 64 * 1024;
+constexpr const VkFormat OFFSCREEN_FORMAT = VK_FORMAT_R8G8B8A8_UNORM;
 
-renderer::renderer( const window &window )
+static void
+check_frames_in_flight( uint32_t frames_in_flight )
+{
+    if( frames_in_flight < MIN_FRAMES_IN_FLIGHT || frames_in_flight > MAX_FRAMES_IN_FLIGHT )
+        throw exception{ "Frames in flight must be between 1 and 4.", __FILE__, __LINE__ };
+}
+
+renderer::renderer( const window &window, uint32_t frames_in_flight, const vk::graphics::swapchain_settings& swapchain_settings )
     :
-    window_( window )
+    p_window_( &window ),
+    swapchain_settings_( swapchain_settings )
 {
-    instance_                   = vk::core::instance( window_.get_title(), validation_layers, window_.get_required_extensions() );
+    check_frames_in_flight( frames_in_flight );
+
+    instance_                   = vk::core::instance( p_window_->get_title(), validation_layers, p_window_->get_required_extensions() );
 
     if constexpr ( enable_validation_layers )
         debug_report_           = vk::core::debug_report( &instance_ );
 
-    surface_                    = vk::graphics::surface( &instance_, window_ );
+    surface_                    = vk::graphics::surface( &instance_, *p_window_ );
     gpu_                        = vk::core::physical_device( instance_, surface_ );
-    logical_device_             = vk::core::logical_device( gpu_, validation_layers, device_extensions );
-    graphics_queue_             = vk::core::queue( logical_device_, gpu_, vk::helpers::queue_family_type::e_graphics, 0 );
+
+    create_device( );
+
     present_queue_              = vk::core::queue( logical_device_, gpu_, vk::helpers::queue_family_type::e_present, 0 );
-    command_pool_               = vk::core::command_pool( gpu_, &logical_device_, vk::helpers::queue_family_type::e_graphics );
 
-    image_available_semaphores_ = vk::core::semaphores( &logical_device_, MAX_FRAMES_IN_FLIGHT );
-    render_finished_semaphores_ = vk::core::semaphores( &logical_device_, MAX_FRAMES_IN_FLIGHT );
-    fences_                     = vk::core::fences( &logical_device_, MAX_FRAMES_IN_FLIGHT );
+    frame_buffer_extent_        = p_window_->get_frame_buffer_extent();
 
-    swapchain_                  = vk::graphics::swapchain( &logical_device_, gpu_, surface_, window_.get_width(), window_.get_height(), swapchain_.get() );
+    swapchain_                  = vk::graphics::swapchain( &logical_device_, gpu_, surface_, frame_buffer_extent_.width, frame_buffer_extent_.height, swapchain_.get(),
+                                                           swapchain_settings_ );
     render_pass_                = vk::core::render_pass( &logical_device_, swapchain_ );
+    render_pass_format_         = swapchain_.get_format();
 
-    descriptor_pool_            = vk::core::descriptor_pool( &logical_device_, swapchain_.get_count() );
-    descriptor_set_layout_      = vk::core::descriptor_set_layout( &logical_device_, VK_SHADER_STAGE_VERTEX_BIT );
-
+    create_descriptors( );
 
     frame_buffers_              = vk::graphics::frame_buffers( &logical_device_, render_pass_, swapchain_, swapchain_.get_count() );
-    command_buffers_            = vk::core::command_buffers( &command_pool_, frame_buffers_.get_count() );
+
+    create_frame_contexts( frames_in_flight );
+}
+renderer::renderer( uint32_t width, uint32_t height, uint32_t frames_in_flight )
+    :
+    is_headless_( true )
+{
+    check_frames_in_flight( frames_in_flight );
+
+    /*
+     * Nothing is presented, so neither the surface nor the swapchain extensions are asked for.
+     */
+    device_extensions.clear();
+
+    instance_                   = vk::core::instance( "Projekt - headless", validation_layers, { } );
+
+    if constexpr ( enable_validation_layers )
+        debug_report_           = vk::core::debug_report( &instance_ );
+
+    gpu_                        = vk::core::physical_device( instance_, vk::helpers::queue_family_type::e_graphics );
+
+    create_device( );
+
+    render_pass_                = vk::core::render_pass( &logical_device_, OFFSCREEN_FORMAT, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL );
+    render_pass_format_         = OFFSCREEN_FORMAT;
+
+    create_descriptors( );
+
+    create_frame_contexts( frames_in_flight );
+    create_offscreen_target( width, height );
 }
 
 renderer::~renderer()
 {
     graphics_queue_.wait_idle( );
+    pipeline_builder_.wait_idle( );
+
+    try
+    {
+        pipeline_cache_.save( );
+    }
+    catch( const std::exception& e )
+    {
+        std::cerr << "Failed to save the pipeline cache: " << e.what() << std::endl;
+    }
+}
+
+void
+renderer::create_device( )
+{
+    /*
+     * Only what the GPU driven path and the pipeline states can make use of is turned on, and only when present.
+     */
+    {
+        auto supported_features = gpu_.get_supported_features();
+
+        VkPhysicalDeviceFeatures features = {};
+        features.multiDrawIndirect = supported_features.multiDrawIndirect;
+        features.drawIndirectFirstInstance = supported_features.drawIndirectFirstInstance;
+        features.fillModeNonSolid = supported_features.fillModeNonSolid;
+
+        gpu_.set_device_features( features );
+
+        has_draw_indirect_count_ = gpu_.is_extension_supported( VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME );
+        if( has_draw_indirect_count_ )
+            device_extensions.push_back( VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME );
+
+        has_timeline_semaphore_ = gpu_.is_timeline_semaphore_supported();
+        if( has_timeline_semaphore_ )
+            device_extensions.push_back( VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME );
+    }
+
+    logical_device_             = vk::core::logical_device( gpu_, validation_layers, device_extensions, has_timeline_semaphore_ );
+
+    {
+        const auto start = std::chrono::steady_clock::now( );
+
+        pipeline_cache_         = vk::core::pipeline_cache( &logical_device_, gpu_, PIPELINE_CACHE_PATH );
+
+        const auto load_time = std::chrono::duration<double, std::milli>( std::chrono::steady_clock::now( ) - start ).count( );
+
+        std::cout << "Pipeline cache: " << ( pipeline_cache_.is_warm() ? "warm, " : "cold, " )
+                  << pipeline_cache_.get_loaded_size() << " bytes loaded in " << load_time << " ms" << std::endl;
+    }
+
+    graphics_queue_             = vk::core::queue( logical_device_, gpu_, vk::helpers::queue_family_type::e_graphics, 0 );
+    memory_allocator_           = vk::core::memory_allocator( &logical_device_, gpu_ );
+    upload_manager_             = vk::core::upload_manager( &logical_device_, &memory_allocator_, gpu_ );
+
+    frame_timeline_             = vk::core::timeline_semaphore( &logical_device_ );
+}
+void
+renderer::create_descriptors( )
+{
+    descriptor_pool_            = vk::core::descriptor_pool( &logical_device_, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1 );
+    descriptor_set_layout_      = vk::core::descriptor_set_layout( &logical_device_, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, VK_SHADER_STAGE_VERTEX_BIT );
+    pipeline_builder_           = vk::graphics::pipeline_builder( &logical_device_, pipeline_cache_, render_pass_ );
+}
+void
+renderer::create_offscreen_target( uint32_t width, uint32_t height )
+{
+    frame_buffers_ = vk::graphics::frame_buffers( );
+
+    /*
+     * One image per frame context, so a frame never renders into an image an earlier one may still be using.
+     */
+    offscreen_target_ = vk::graphics::offscreen_target( &logical_device_, &memory_allocator_, width, height, frames_in_flight_, OFFSCREEN_FORMAT );
+    frame_buffers_ = vk::graphics::frame_buffers( &logical_device_, render_pass_, offscreen_target_.get_image_views(),
+                                                  offscreen_target_.get_extent(), offscreen_target_.get_count() );
+}
+
+void
+renderer::set_frames_in_flight( uint32_t frames_in_flight )
+{
+    check_frames_in_flight( frames_in_flight );
+
+    if( frames_in_flight == frames_in_flight_ )
+        return;
+
+    /*
+     * Every context is about to be replaced, so nothing may still be in flight. Retired resources are
+     * then unreferenced as well and the queue can start over with the new latency.
+     */
+    frame_timeline_.wait( frame_timeline_.get_last_submitted_value() );
+
+    deletion_queue_.flush( );
+
+    create_frame_contexts( frames_in_flight );
+
+    if( is_headless_ )
+        create_offscreen_target( offscreen_target_.get_extent().width, offscreen_target_.get_extent().height );
+}
+
+void
+renderer::set_present_policy( vk::graphics::present_policy policy )
+{
+    swapchain_settings_.policy = policy;
+
+    /*
+     * Goes through the same path as a resize, the swapchain is rebuilt on the next acquire.
+     */
+    if( !is_resize_pending_ && !is_headless_ )
+        request_resize( frame_buffer_extent_.width, frame_buffer_extent_.height, true );
+}
+void
+renderer::set_swapchain_image_count( uint32_t image_count )
+{
+    swapchain_settings_.image_count = image_count;
+
+    if( !is_resize_pending_ && !is_headless_ )
+        request_resize( frame_buffer_extent_.width, frame_buffer_extent_.height, true );
 }
 
 void
 renderer::create_pipeline( std::string&& vertex_shader, std::string&& fragment_shader )
 {
-    vertex_shader_              = vk::core::shader_module( &logical_device_, vertex_shader );
-    fragment_shader_            = vk::core::shader_module( &logical_device_, fragment_shader );
-    graphics_pipeline_          = vk::graphics::graphics_pipeline( &logical_device_, render_pass_, swapchain_, descriptor_set_layout_, vertex_shader_, fragment_shader_ );
+    const auto start = std::chrono::steady_clock::now( );
+
+    fragment_shader_path_ = std::move( fragment_shader );
+
+    vk::graphics::pipeline_description description = {};
+    description.vertex_shader_path = std::move( vertex_shader );
+    description.fragment_shader_path = fragment_shader_path_;
+    description.p_descriptor_set_layout = &descriptor_set_layout_;
+
+    replace_pipeline( description, default_pipeline_id_, p_default_pipeline_ );
+
+    const auto creation_time = std::chrono::duration<double, std::milli>( std::chrono::steady_clock::now( ) - start ).count( );
+
+    std::cout << "Graphics pipeline created in " << creation_time << " ms ("
+              << ( pipeline_cache_.is_warm() ? "warm" : "cold" ) << " start)" << std::endl;
+}
+uint32_t
+renderer::request_pipeline( std::string&& vertex_shader, std::string&& fragment_shader, const vk::graphics::pipeline_state& state )
+{
+    vk::graphics::pipeline_description description = {};
+    description.vertex_shader_path = std::move( vertex_shader );
+    description.fragment_shader_path = std::move( fragment_shader );
+    description.p_descriptor_set_layout = &descriptor_set_layout_;
+    description.state = state;
+
+    return pipeline_builder_.submit( description );
+}
+void
+renderer::create_instanced_pipeline( std::string&& vertex_shader )
+{
+    vk::graphics::pipeline_description description = {};
+    description.vertex_shader_path = std::move( vertex_shader );
+    description.fragment_shader_path = fragment_shader_path_;
+    description.p_descriptor_set_layout = &descriptor_set_layout_;
+    description.vertex_input = vk::graphics::instance_data::get_input_description();
+
+    replace_pipeline( description, instanced_pipeline_id_, p_instanced_pipeline_ );
+    is_instancing_ = true;
 }
 void
 renderer::prepare_for_rendering( const std::vector<vk::graphics::vertex>& vertices, const std::vector<std::uint16_t>& indices )
 {
-    create_vertex_buffer( vertices );
-    create_index_buffer( indices );
+    set_mesh( vertices, indices );
+
+    /*
+     * The ring always has a slice for the largest frame count, so changing it never touches the descriptor sets.
+     */
+    uniform_buffers_ = vk::graphics::uniform_buffers( &logical_device_, &memory_allocator_, gpu_, UNIFORM_FRAME_SIZE, MAX_FRAMES_IN_FLIGHT );
+    descriptor_sets_ = vk::core::descriptor_sets( logical_device_, &descriptor_pool_, descriptor_set_layout_, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
+                                                  &uniform_buffers_.get(), sizeof( vk::graphics::uniform_buffer_object ), 1 );
+}
+
+void
+renderer::prepare_gpu_driven_rendering( std::string&& vertex_shader, std::string&& cull_shader, uint32_t max_object_count )
+{
+    if( !gpu_.features().drawIndirectFirstInstance )
+        throw vulkan_exception{ "GPU driven rendering requires the drawIndirectFirstInstance feature.", __FILE__, __LINE__ };
+
+    PFN_vkCmdDrawIndexedIndirectCountKHR p_draw_indirect_count = nullptr;
+    if( has_draw_indirect_count_ )
+    {
+        p_draw_indirect_count = reinterpret_cast<PFN_vkCmdDrawIndexedIndirectCountKHR>(
+            logical_device_.get_proc_address( "vkCmdDrawIndexedIndirectCountKHR" ) );
+    }
+
+    gpu_driven_scene_ = vk::graphics::gpu_driven_scene( &logical_device_, &memory_allocator_, pipeline_cache_, upload_manager_, cull_shader, max_object_count,
+                                                        p_draw_indirect_count, gpu_.features().multiDrawIndirect == VK_TRUE );
+
+    VkDescriptorSetLayoutBinding uniform_binding = {};
+    uniform_binding.binding = 0;
+    uniform_binding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+    uniform_binding.descriptorCount = 1;
+    uniform_binding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+
+    VkDescriptorSetLayoutBinding object_binding = {};
+    object_binding.binding = 1;
+    object_binding.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    object_binding.descriptorCount = 1;
+    object_binding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+
+    indirect_descriptor_set_layout_ = vk::core::descriptor_set_layout( &logical_device_, { uniform_binding, object_binding } );
+
+    create_indirect_descriptor_set( );
+
+    vk::graphics::pipeline_description description = {};
+    description.vertex_shader_path = std::move( vertex_shader );
+    description.fragment_shader_path = fragment_shader_path_;
+    description.p_descriptor_set_layout = &indirect_descriptor_set_layout_;
+
+    replace_pipeline( description, indirect_pipeline_id_, p_indirect_pipeline_ );
+
+    is_gpu_driven_ = true;
+}
+
+void
+renderer::set_objects( const std::vector<vk::graphics::object_data>& objects )
+{
+    gpu_driven_scene_.set_objects( upload_manager_, deletion_queue_, objects );
+
+    /*
+     * Binding 1 now refers to the new object buffer, while frames in flight may still be
+     * bound to the current set, so it is written into a fresh one.
+     */
+    create_indirect_descriptor_set( );
+
+    upload_ticket_ = upload_manager_.flush( );
+}
+
+void
+renderer::create_indirect_descriptor_set( )
+{
+    deletion_queue_.retire( std::move( indirect_descriptor_pool_ ) );
+
+    indirect_descriptor_pool_ = vk::core::descriptor_pool( &logical_device_, { { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1 },
+                                                                               { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1 } }, 1 );
+    indirect_descriptor_sets_ = vk::core::descriptor_sets( logical_device_, &indirect_descriptor_pool_, indirect_descriptor_set_layout_,
+                                                           VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
+                                                           { { uniform_buffers_.get(), 0, sizeof( vk::graphics::uniform_buffer_object ) } } );
+    indirect_descriptor_sets_.update( logical_device_, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                                      { { gpu_driven_scene_.get_object_buffer(), 0, VK_WHOLE_SIZE } }, 0, 1 );
+}
+
+void
+renderer::set_instances( const std::vector<vk::graphics::instance_data>& instances )
+{
+    /*
+     * Frames in flight may still be reading the current instance stream, it is retired rather than destroyed.
+     */
+    deletion_queue_.retire( std::move( instance_buffer_ ) );
+
+    /*
+     * An empty list only clears the stream, instanced draws are skipped until instances are set again.
+     */
+    if( instances.empty() )
+        return;
 
-    uniform_buffers_ = vk::graphics::uniform_buffers( &logical_device_, gpu_, swapchain_.get_count() );
-    descriptor_sets_ = vk::core::descriptor_sets( logical_device_, &descriptor_pool_, descriptor_set_layout_, uniform_buffers_.get(),
-                                                  sizeof( vk::graphics::uniform_buffer_object ), swapchain_.get_count() );
+    instance_buffer_ = vk::core::instance_buffer( &logical_device_, &memory_allocator_, upload_manager_, instances );
 
-    record_commands( );
+    upload_ticket_ = upload_manager_.flush( );
 }
 
+bool
+renderer::recreate_swapchain( uint32_t width, uint32_t height )
+{
+    cpu_profiler::zone zone( "recreate swapchain" );
+
+    /*
+     * A minimised window has no extent to build a swapchain for, keep the old one until it comes back.
+     */
+    if( width == 0 || height == 0 )
+        return false;
+
+    /*
+     * The old swapchain is handed over as oldSwapchain and retired, together with its framebuffers,
+     * until every frame that might still be using them has passed its fence.
+     */
+    auto old_swapchain = std::move( swapchain_ );
+
+    swapchain_ = vk::graphics::swapchain( &logical_device_, gpu_, surface_, width, height, old_swapchain.get(), swapchain_settings_ );
+
+    deletion_queue_.retire( std::move( old_swapchain ) );
+    deletion_queue_.retire( std::move( frame_buffers_ ) );
+
+    /*
+     * Viewport and scissor are dynamic, so only a change of surface format invalidates the render pass
+     * and, through it, the pipelines. Framebuffers always follow the swapchain images.
+     */
+    if( swapchain_.get_format() != render_pass_format_ )
+        recreate_render_pass( );
+
+    frame_buffers_ = vk::graphics::frame_buffers( &logical_device_, render_pass_, swapchain_, swapchain_.get_count() );
+
+    return true;
+}
 void
-renderer::recreate_swapchain( )
+renderer::recreate_render_pass( )
 {
+    /*
+     * Only reached when the surface format changes, which is rare enough to afford a full stall.
+     */
+    pipeline_builder_.wait_idle( );
     logical_device_.wait_idle( );
 
-    swapchain_ = vk::graphics::swapchain( &logical_device_, gpu_, surface_, window_.get_width(), window_.get_height(), swapchain_.get() );
     render_pass_ = vk::core::render_pass( &logical_device_, swapchain_ );
+    render_pass_format_ = swapchain_.get_format();
+
+    /*
+     * Every pipeline is rebuilt in place. The ones drawn with directly are waited on since there
+     * is nothing to fall back to, the others fall back to the default pipeline until they are done.
+     */
+    pipeline_builder_.rebuild_all( );
 
-    graphics_pipeline_ = vk::graphics::graphics_pipeline( &logical_device_, render_pass_, swapchain_, descriptor_set_layout_, vertex_shader_, fragment_shader_ );
+    p_default_pipeline_ = wait_for_pipeline( default_pipeline_id_ );
 
-    frame_buffers_ = vk::graphics::frame_buffers( &logical_device_, render_pass_, swapchain_, swapchain_.get_count() );
-    command_buffers_ = vk::core::command_buffers( &command_pool_, frame_buffers_.get_count() );
+    if( is_instancing_ )
+        p_instanced_pipeline_ = wait_for_pipeline( instanced_pipeline_id_ );
 
-    record_commands( );
+    if( is_gpu_driven_ )
+        p_indirect_pipeline_ = wait_for_pipeline( indirect_pipeline_id_ );
 }
 
+/*
+ * The new pipeline is waited on before the old one is released, so a shader that fails to build
+ * leaves the current one in place.
+ */
 void
+renderer::replace_pipeline( const vk::graphics::pipeline_description& description, vk::graphics::pipeline_builder::pipeline_id& id,
+                            vk::graphics::graphics_pipeline*& p_pipeline )
+{
+    const auto new_id = pipeline_builder_.submit( description );
+
+    vk::graphics::graphics_pipeline* p_new_pipeline;
+    try
+    {
+        p_new_pipeline = wait_for_pipeline( new_id );
+    }
+    catch( ... )
+    {
+        pipeline_builder_.release( new_id, deletion_queue_ );
+        throw;
+    }
+
+    if( p_pipeline != nullptr )
+        pipeline_builder_.release( id, deletion_queue_ );
+
+    id = new_id;
+    p_pipeline = p_new_pipeline;
+}
+vk::graphics::graphics_pipeline*
+renderer::wait_for_pipeline( vk::graphics::pipeline_builder::pipeline_id id )
+{
+    pipeline_builder_.wait( id );
+
+    return pipeline_builder_.try_get( id );
+}
+
+vk::core::command_buffers&
 renderer::record_commands( )
 {
-    VkViewport viewport = { 0, 0, swapchain_.get_extent().width, swapchain_.get_extent().height , 0, 0 };
-    VkRect2D scissor = { { 0, 0 }, swapchain_.get_extent() };
+    cpu_profiler::zone zone( "record commands" );
+
+    auto& frame = frame_contexts_[current_frame_];
+    auto frame_index = frame.index;
+
+    auto& command_buffer = frame.command_pool.acquire( VK_COMMAND_BUFFER_LEVEL_PRIMARY );
+
+    command_buffer.begin( VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT, 0 );
+
+    gpu_profiler_.begin_frame( command_buffer, frame_index, 0 );
+    auto frame_scope = gpu_profiler_.begin_scope( command_buffer, "frame", 0 );
+
+    if( is_gpu_driven_ )
+    {
+        vk::graphics::gpu_profiler::scope culling_scope( gpu_profiler_, command_buffer, "culling", 0 );
+
+        gpu_driven_scene_.record_culling( command_buffer, 0, view_projection_ );
+    }
 
-    for( auto i = 0; i < command_buffers_.get_count(); ++i )
     {
-        command_buffers_.begin( VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT, i );
+        vk::graphics::gpu_profiler::scope main_pass_scope( gpu_profiler_, command_buffer, "main pass", 0 );
+
+        VkClearValue clear_colour = { 0.0f, 0.0f, 0.0f, 1.0f };
+
+        VkRenderPassBeginInfo render_pass_begin_info = {};
+        render_pass_begin_info.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+        render_pass_begin_info.renderPass = render_pass_.get();
+        render_pass_begin_info.framebuffer = frame_buffers_[image_index_];
+        render_pass_begin_info.renderArea.offset = { 0, 0 };
+        render_pass_begin_info.renderArea.extent = get_extent( );
+        render_pass_begin_info.clearValueCount = 1;
+        render_pass_begin_info.pClearValues = &clear_colour;
+
+        command_buffer.begin_render_pass( render_pass_begin_info, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS, 0 );
 
         {
-            VkClearValue clear_colour = { 0.0f, 0.0f, 0.0f, 1.0f };
+            VkCommandBufferInheritanceInfo inheritance_info = {};
+            inheritance_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+            inheritance_info.renderPass = render_pass_.get();
+            inheritance_info.subpass = 0;
+            inheritance_info.framebuffer = frame_buffers_[image_index_];
 
-            VkRenderPassBeginInfo render_pass_begin_info = {};
-            render_pass_begin_info.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-            render_pass_begin_info.renderPass = render_pass_.get();
-            render_pass_begin_info.framebuffer = frame_buffers_[i];
-            render_pass_begin_info.renderArea.offset = { 0, 0 };
-            render_pass_begin_info.renderArea.extent = swapchain_.get_extent();
-            render_pass_begin_info.clearValueCount = 1;
-            render_pass_begin_info.pClearValues = &clear_colour;
+            resolve_pipelines( );
 
-            command_buffers_.begin_render_pass( render_pass_begin_info, VK_SUBPASS_CONTENTS_INLINE, i );
+            const auto& secondary_command_buffers = parallel_recorder_.record( frame_index, inheritance_info, draw_calls_.size(),
+                [this]( vk::core::command_buffers& command_buffers, uint32_t index, size_t first, size_t last )
+                {
+                    record_draw_calls( command_buffers, index, first, last );
+                } );
 
+            secondary_command_buffers_.assign( secondary_command_buffers.begin(), secondary_command_buffers.end() );
+
+            if( !instanced_draw_calls_.empty() && instance_buffer_.get() != VK_NULL_HANDLE )
             {
-                command_buffers_.set_viewport( 0, 1, &viewport, i );
-                command_buffers_.set_scissor( 0, 1, &scissor, i );
+                auto& instanced_command_buffer = frame.command_pool.acquire( VK_COMMAND_BUFFER_LEVEL_SECONDARY );
+
+                instanced_command_buffer.begin( VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT,
+                                                inheritance_info, 0 );
+                record_instanced_draw_calls( instanced_command_buffer, 0 );
+                instanced_command_buffer.end( 0 );
 
-                command_buffers_.bind_pipeline( VK_PIPELINE_BIND_POINT_GRAPHICS, graphics_pipeline_.get(), i );
+                secondary_command_buffers_.push_back( instanced_command_buffer[0] );
+            }
 
-                VkDeviceSize offsets[] = { 0 };
+            if( is_gpu_driven_ && gpu_driven_scene_.get_object_count() > 0 )
+            {
+                auto& indirect_command_buffer = frame.command_pool.acquire( VK_COMMAND_BUFFER_LEVEL_SECONDARY );
 
-                command_buffers_.bind_vertex_buffers( 0, 1, &vertex_buffer_.get(), offsets, i );
-                command_buffers_.bind_index_buffer( index_buffer_.get(), 0, VK_INDEX_TYPE_UINT16, i );
+                indirect_command_buffer.begin( VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT,
+                                               inheritance_info, 0 );
+                record_indirect_draws( indirect_command_buffer, 0 );
+                indirect_command_buffer.end( 0 );
 
-                command_buffers_.bind_descriptor_sets( VK_PIPELINE_BIND_POINT_GRAPHICS, graphics_pipeline_.get_layout(), 0, 1, &descriptor_sets_[i], 0, nullptr, i );
-                command_buffers_.draw_indexed( index_buffer_.get_count(), 1, 0, 0, 0, i );
+                secondary_command_buffers_.push_back( indirect_command_buffer[0] );
             }
 
-            command_buffers_.end_render_pass( i );
+            if( !secondary_command_buffers_.empty() )
+            {
+                command_buffer.execute_commands( static_cast<uint32_t>( secondary_command_buffers_.size() ),
+                                                 secondary_command_buffers_.data(), 0 );
+            }
         }
 
-        command_buffers_.end( i );
+        command_buffer.end_render_pass( 0 );
     }
 
+    if( is_readback_requested_ )
+    {
+        vk::graphics::gpu_profiler::scope readback_scope( gpu_profiler_, command_buffer, "readback", 0 );
+
+        offscreen_target_.record_readback( command_buffer, image_index_, 0 );
+    }
+
+    gpu_profiler_.end_scope( command_buffer, frame_scope, 0 );
+
+    command_buffer.end( 0 );
+
+    draw_calls_.clear();
+    instanced_draw_calls_.clear();
+
+    return command_buffer;
+}
+void
+renderer::record_draw_calls( vk::core::command_buffers& command_buffers, uint32_t index, size_t first, size_t last )
+{
+    VkViewport viewport = { 0, 0, static_cast<float>( get_extent( ).width ), static_cast<float>( get_extent( ).height ), 0, 0 };
+    VkRect2D scissor = { { 0, 0 }, get_extent( ) };
+
+    command_buffers.set_viewport( 0, 1, &viewport, index );
+    command_buffers.set_scissor( 0, 1, &scissor, index );
+
+    VkDeviceSize offsets[] = { 0 };
+
+    command_buffers.bind_vertex_buffers( 0, 1, &vertex_buffer_.get(), offsets, index );
+    command_buffers.bind_index_buffer( index_buffer_.get(), 0, VK_INDEX_TYPE_UINT16, index );
+
+    /*
+     * Every pipeline from the builder shares the default pipeline's descriptor set layout,
+     * so the set stays bound across pipeline switches.
+     */
+    command_buffers.bind_descriptor_sets( VK_PIPELINE_BIND_POINT_GRAPHICS, p_default_pipeline_->get_layout(), 0, 1, &descriptor_sets_[0], 1, &uniform_offset_, index );
+
+    VkPipeline bound_pipeline = VK_NULL_HANDLE;
+
+    for( auto i = first; i < last; ++i )
+    {
+        const auto& draw_call = draw_calls_[i];
+
+        auto pipeline = draw_call.pipeline_id == vk::graphics::DEFAULT_PIPELINE_ID ? p_default_pipeline_->get()
+                                                                                    : resolved_pipelines_.at( draw_call.pipeline_id );
+        if( pipeline != bound_pipeline )
+        {
+            command_buffers.bind_pipeline( VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline, index );
+            bound_pipeline = pipeline;
+        }
+
+        command_buffers.draw_indexed( draw_call.index_count, draw_call.instance_count, draw_call.first_index,
+                                      draw_call.vertex_offset, draw_call.first_instance, index );
+    }
+}
+
+void
+renderer::resolve_pipelines( )
+{
     /*
-     *
+     * Done once per frame on the calling thread so the recording workers only ever read a plain array.
+     * Pipelines still being compiled, or that failed to, fall back to the default pipeline rather than
+     * stalling or ending the frame.
      */
+    const auto pipeline_count = pipeline_builder_.get_pipeline_count( );
+
+    resolved_pipelines_.resize( pipeline_count );
+    for( uint32_t id = 0; id < pipeline_count; ++id )
+    {
+        auto* p_pipeline = pipeline_builder_.try_get( id );
+
+        resolved_pipelines_[id] = p_pipeline != nullptr ? p_pipeline->get() : p_default_pipeline_->get();
+    }
+}
+void
+renderer::record_instanced_draw_calls( vk::core::command_buffers& command_buffers, uint32_t index )
+{
+    VkViewport viewport = { 0, 0, static_cast<float>( get_extent( ).width ), static_cast<float>( get_extent( ).height ), 0, 0 };
+    VkRect2D scissor = { { 0, 0 }, get_extent( ) };
+
+    command_buffers.set_viewport( 0, 1, &viewport, index );
+    command_buffers.set_scissor( 0, 1, &scissor, index );
+
+    command_buffers.bind_pipeline( VK_PIPELINE_BIND_POINT_GRAPHICS, p_instanced_pipeline_->get(), index );
+
+    VkBuffer vertex_buffers[] = { vertex_buffer_.get(), instance_buffer_.get() };
+    VkDeviceSize offsets[] = { 0, 0 };
+
+    command_buffers.bind_vertex_buffers( 0, 2, vertex_buffers, offsets, index );
+    command_buffers.bind_index_buffer( index_buffer_.get(), 0, VK_INDEX_TYPE_UINT16, index );
+
+    command_buffers.bind_descriptor_sets( VK_PIPELINE_BIND_POINT_GRAPHICS, p_instanced_pipeline_->get_layout(), 0, 1, &descriptor_sets_[0], 1, &uniform_offset_, index );
+
+    for( const auto& draw_call : instanced_draw_calls_ )
+    {
+        command_buffers.draw_indexed( draw_call.index_count, draw_call.instance_count, draw_call.first_index,
+                                      draw_call.vertex_offset, draw_call.first_instance, index );
+    }
+}
+void
+renderer::record_indirect_draws( vk::core::command_buffers& command_buffers, uint32_t index )
+{
+    VkViewport viewport = { 0, 0, static_cast<float>( get_extent( ).width ), static_cast<float>( get_extent( ).height ), 0, 0 };
+    VkRect2D scissor = { { 0, 0 }, get_extent( ) };
+
+    command_buffers.set_viewport( 0, 1, &viewport, index );
+    command_buffers.set_scissor( 0, 1, &scissor, index );
+
+    command_buffers.bind_pipeline( VK_PIPELINE_BIND_POINT_GRAPHICS, p_indirect_pipeline_->get(), index );
+
+    VkDeviceSize offsets[] = { 0 };
+
+    command_buffers.bind_vertex_buffers( 0, 1, &vertex_buffer_.get(), offsets, index );
+    command_buffers.bind_index_buffer( index_buffer_.get(), 0, VK_INDEX_TYPE_UINT16, index );
+
+    command_buffers.bind_descriptor_sets( VK_PIPELINE_BIND_POINT_GRAPHICS, p_indirect_pipeline_->get_layout(), 0, 1, &indirect_descriptor_sets_[0], 1, &uniform_offset_, index );
+
+    gpu_driven_scene_.record_draw( command_buffers, index );
 }
 
 void
 renderer::prepare_frame( )
 {
-    fences_.wait_for_fence( current_frame_, VK_TRUE, std::numeric_limits<uint64_t>::max() );
-    fences_.reset_fence( current_frame_ );
+    cpu_profiler::zone zone( "prepare frame" );
 
-    auto result = swapchain_.acquire_next_image( std::numeric_limits<uint64_t>::max(), image_available_semaphores_[current_frame_], VK_NULL_HANDLE, &image_index_ );
+    auto& frame = frame_contexts_[current_frame_];
 
-    if( result == VK_ERROR_OUT_OF_DATE_KHR )
+    /*
+     * Only the value signaled by the last submission that used this context is needed.
+     */
     {
-        recreate_swapchain( );
+        cpu_profiler::zone wait_zone( "wait for frame" );
+
+        frame_timeline_.wait( frame.timeline_value );
     }
-    else if( result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR )
+
+    /*
+     * The frame frames_in_flight_ back has just been waited on, anything retired
+     * up to that frame is no longer referenced by the device.
+     */
+    deletion_queue_.begin_frame( frame_number_ );
+
+    frame.command_pool.reset( );
+
+    uniform_buffers_.begin_frame( frame.index );
+}
+bool
+renderer::acquire_next_image( )
+{
+    cpu_profiler::zone zone( "acquire image" );
+
+    /*
+     * Offscreen images belong to their frame context, which prepare_frame has already waited on.
+     */
+    if( is_headless_ )
     {
-        throw vulkan_exception{ "Failed to acquire swapchain image", __FILE__, __LINE__ };
+        image_index_ = frame_contexts_[current_frame_].index;
+        return true;
+    }
+
+    if( is_resize_pending_ )
+    {
+        is_resize_pending_ = false;
+        is_frame_buffer_extent_pending_ = false;
+
+        if( !recreate_swapchain( pending_extent_.width, pending_extent_.height ) )
+            return false;
     }
+
+    auto result = swapchain_.acquire_next_image( std::numeric_limits<uint64_t>::max(), frame_contexts_[current_frame_].image_available_semaphore[0], VK_NULL_HANDLE, &image_index_ );
+
+    if( result == VK_ERROR_OUT_OF_DATE_KHR )
+    {
+        /*
+         * No semaphore was signaled, so acquiring again from the new swapchain is safe.
+         */
+        if( !recreate_swapchain( frame_buffer_extent_.width, frame_buffer_extent_.height ) )
+            return false;
+
+        result = swapchain_.acquire_next_image( std::numeric_limits<uint64_t>::max(), frame_contexts_[current_frame_].image_available_semaphore[0], VK_NULL_HANDLE, &image_index_ );
+
+        if( result == VK_ERROR_OUT_OF_DATE_KHR )
+            return false;
+    }
+
+    if( result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR )
+        throw vulkan_exception{ "Failed to acquire swapchain image", __FILE__, __LINE__ };
+
+    return true;
 }
 
 void
 renderer::submit_frame( )
 {
-    VkSemaphore wait_semaphores[] = { image_available_semaphores_[current_frame_] };
-    VkSemaphore signal_semaphores[] = { render_finished_semaphores_[current_frame_] };
+    cpu_profiler::zone zone( "submit frame" );
+
+    /*
+     * The image is acquired as late as possible, only once everything up to recording is done.
+     * Recording comes after it since a resize handled here may replace the render pass and pipelines.
+     */
+    if( !acquire_next_image( ) )
+    {
+        draw_calls_.clear();
+        instanced_draw_calls_.clear();
+
+        return;
+    }
+
+    auto& frame = frame_contexts_[current_frame_];
+
+    auto& command_buffer = record_commands( );
+
+    VkSemaphore wait_semaphores[] = { frame.image_available_semaphore[0] };
+    VkSemaphore signal_semaphores[] = { frame.render_finished_semaphore[0] };
     VkPipelineStageFlags wait_stages[] = { VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT };
 
+    /*
+     * Without a swapchain there is no image to wait for and nothing to present.
+     */
     VkSubmitInfo submit_info = {};
     submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-    submit_info.waitSemaphoreCount = 1;
+    submit_info.waitSemaphoreCount = is_headless_ ? 0 : 1;
     submit_info.pWaitSemaphores = wait_semaphores;
     submit_info.pWaitDstStageMask = wait_stages;
     submit_info.commandBufferCount = 1;
-    submit_info.pCommandBuffers = &command_buffers_[image_index_];
-    submit_info.signalSemaphoreCount = 1;
+    submit_info.pCommandBuffers = &command_buffer[0];
+    submit_info.signalSemaphoreCount = is_headless_ ? 0 : 1;
     submit_info.pSignalSemaphores = signal_semaphores;
 
-    graphics_queue_.submit( submit_info, fences_[current_frame_] );
+    /*
+     * Pending uploads are chained on the GPU rather than waited for here.
+     */
+    std::vector<vk::core::timeline_wait> timeline_waits;
+    if( !upload_manager_.is_complete( upload_ticket_ ) )
+        timeline_waits.push_back( { &upload_manager_.get_timeline(), upload_ticket_, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT } );
 
-    VkSwapchainKHR swapchains[] = { swapchain_.get() };
-    VkPresentInfoKHR present_info = {};
-    present_info.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
-    present_info.waitSemaphoreCount = 1;
-    present_info.pWaitSemaphores = signal_semaphores;
-    present_info.swapchainCount = 1;
-    present_info.pSwapchains = swapchains;
-    present_info.pImageIndices = &image_index_;
+    frame.timeline_value = frame_timeline_.submit( graphics_queue_, submit_info, timeline_waits );
 
-    auto result = present_queue_.present( present_info );
+    gpu_profiler_.end_frame( );
 
-    if( result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR )
+    if( is_headless_ )
     {
-        recreate_swapchain( );
+        if( is_readback_requested_ )
+        {
+            is_readback_requested_ = false;
+            readback_value_ = frame.timeline_value;
+        }
     }
-    else if( result != VK_SUCCESS )
+    else
     {
-        throw vulkan_exception{ "Failed to present swapchain image", __FILE__, __LINE__ };
+        VkSwapchainKHR swapchains[] = { swapchain_.get() };
+        VkPresentInfoKHR present_info = {};
+        present_info.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+        present_info.waitSemaphoreCount = 1;
+        present_info.pWaitSemaphores = signal_semaphores;
+        present_info.swapchainCount = 1;
+        present_info.pSwapchains = swapchains;
+        present_info.pImageIndices = &image_index_;
+
+        auto result = present_queue_.present( present_info );
+
+        if( result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR )
+        {
+            if( !is_resize_pending_ )
+                request_resize( frame_buffer_extent_.width, frame_buffer_extent_.height, true );
+        }
+        else if( result != VK_SUCCESS )
+        {
+            throw vulkan_exception{ "Failed to present swapchain image", __FILE__, __LINE__ };
+        }
     }
 
-    current_frame_ = ( current_frame_ + 1 ) % MAX_FRAMES_IN_FLIGHT;
+    ++frame_number_;
+    current_frame_ = ( current_frame_ + 1 ) % frames_in_flight_;
+}
+
+void
+renderer::request_readback( )
+{
+    if( !is_headless_ )
+        throw exception{ "Readback is only available when rendering offscreen.", __FILE__, __LINE__ };
+
+    is_readback_requested_ = true;
+}
+bool
+renderer::read_back( std::vector<uint8_t>& pixels )
+{
+    if( readback_value_ == 0 )
+        return false;
+
+    frame_timeline_.wait( readback_value_ );
+    offscreen_target_.read_back( pixels );
+
+    /*
+     * Each request is read back once, a later frame may overwrite the readback buffer.
+     */
+    readback_value_ = 0;
+
+    return true;
+}
+
+const VkExtent2D&
+renderer::get_extent( ) const
+{
+    return is_headless_ ? offscreen_target_.get_extent() : swapchain_.get_extent();
+}
+
+void
+renderer::create_frame_contexts( uint32_t frames_in_flight )
+{
+    frames_in_flight_ = frames_in_flight;
+    current_frame_ = 0;
+
+    frame_contexts_.clear();
+    frame_contexts_.reserve( frames_in_flight_ );
+    for( uint32_t i = 0; i < frames_in_flight_; ++i )
+    {
+        vk::graphics::frame_context frame;
+        frame.index = i;
+        frame.command_pool = vk::core::frame_command_pool( gpu_, &logical_device_, vk::helpers::queue_family_type::e_graphics );
+        frame.image_available_semaphore = vk::core::semaphores( &logical_device_, 1 );
+        frame.render_finished_semaphore = vk::core::semaphores( &logical_device_, 1 );
+
+        frame_contexts_.emplace_back( std::move( frame ) );
+    }
+
+    parallel_recorder_ = vk::graphics::parallel_recorder( gpu_, &logical_device_, frames_in_flight_ );
+    deletion_queue_ = vk::core::deletion_queue( frames_in_flight_ );
+
+    gpu_profiler_ = vk::graphics::gpu_profiler( &logical_device_, gpu_, frames_in_flight_ );
+    gpu_profiler_.set_trace_writer( p_trace_writer_ );
+}
+
+void
+renderer::set_trace_writer( trace_writer* p_trace_writer )
+{
+    p_trace_writer_ = p_trace_writer;
+
+    gpu_profiler_.set_trace_writer( p_trace_writer_ );
+}
+
+void
+renderer::set_mesh( const std::vector<vk::graphics::vertex>& vertices, const std::vector<std::uint16_t>& indices )
+{
+    create_vertex_buffer( vertices );
+    create_index_buffer( indices );
+
+    upload_ticket_ = upload_manager_.flush( );
 }
 
 void
 renderer::create_vertex_buffer( const std::vector<vk::graphics::vertex>& vertices )
 {
-    vertex_buffer_ = vk::core::vertex_buffer( &logical_device_, gpu_, command_pool_, graphics_queue_, vertices );
+    deletion_queue_.retire( std::move( vertex_buffer_ ) );
+
+    vertex_buffer_ = vk::core::vertex_buffer( &logical_device_, &memory_allocator_, upload_manager_, vertices );
 }
 void
 renderer::create_index_buffer( const std::vector<std::uint16_t>& indices )
 {
-    index_buffer_ = vk::core::index_buffer( &logical_device_, gpu_, command_pool_, graphics_queue_, indices );
+    deletion_queue_.retire( std::move( index_buffer_ ) );
+
+    index_buffer_ = vk::core::index_buffer( &logical_device_, &memory_allocator_, upload_manager_, indices );
 }
 
 void renderer::handle_event( event& e )
 {
     if( e.event_type == event::type::window_resized )
     {
-        handle_window_resizing();
+        handle_window_resizing( e );
     }
     else if( e.event_type == event::type::frame_buffer_resized )
     {
@@ -224,41 +919,58 @@ void renderer::handle_event( event& e )
     }
 }
 
-void renderer::handle_window_resizing( )
+void renderer::handle_window_resizing( event& e )
 {
-    logical_device_.wait_idle( );
-
-    swapchain_.destroy( );
+    request_resize( e.window_resize.width, e.window_resize.height, false );
+}
 
-    surface_ = vk::graphics::surface( &instance_, window_ );
+void renderer::handle_frame_buffer_resizing( event& e )
+{
+    frame_buffer_extent_ = { e.frame_buffer_resize.width, e.frame_buffer_resize.height };
 
-    gpu_.check_surface_present_support( surface_ );
+    request_resize( e.frame_buffer_resize.width, e.frame_buffer_resize.height, true );
+}
 
-    swapchain_ = vk::graphics::swapchain( &logical_device_, gpu_, surface_, window_.get_width( ), window_.get_height( ), swapchain_.get( ) );
-    frame_buffers_ = vk::graphics::frame_buffers( &logical_device_, render_pass_, swapchain_, swapchain_.get_count( ) );
-    command_buffers_ = vk::core::command_buffers( &command_pool_, frame_buffers_.get_count( ) );
+void renderer::request_resize( uint32_t width, uint32_t height, bool is_frame_buffer_extent )
+{
+    /*
+     * Every resize until the next prepare_frame collapses into one pending extent. The framebuffer
+     * size is what the swapchain has to match, so once one has arrived window sizes no longer override it.
+     */
+    if( is_frame_buffer_extent_pending_ && !is_frame_buffer_extent )
+        return;
 
-    record_commands( );
+    pending_extent_ = { width, height };
+    is_resize_pending_ = true;
+    is_frame_buffer_extent_pending_ = is_frame_buffer_extent;
 }
 
-void renderer::handle_frame_buffer_resizing( event& e )
+void renderer::update( glm::mat4& model_matrix, glm::mat4& view_matrix, glm::mat4& projection_matrix )
 {
-    logical_device_.wait_idle( );
+    uniform_offset_ = uniform_buffers_.update( model_matrix, view_matrix, projection_matrix );
 
-    swapchain_.destroy( );
+    auto projection = projection_matrix;
+    projection[1][1] *= -1;
 
-    surface_ = vk::graphics::surface( &instance_, window_ );
+    view_projection_ = projection * view_matrix;
+}
 
-    gpu_.check_surface_present_support( surface_ );
+void renderer::draw( const vk::graphics::draw_call& draw_call )
+{
+    draw_calls_.push_back( draw_call );
+}
+void renderer::draw_instanced( const vk::graphics::draw_call& draw_call )
+{
+    if( !is_instancing_ )
+        throw vulkan_exception{ "Instanced draws need create_instanced_pipeline to be called first.", __FILE__, __LINE__ };
 
-    swapchain_ = vk::graphics::swapchain( &logical_device_, gpu_, surface_, e.frame_buffer_resize.width, e.frame_buffer_resize.height, swapchain_.get( ) );
-    frame_buffers_ = vk::graphics::frame_buffers( &logical_device_, render_pass_, swapchain_, swapchain_.get_count( ) );
-    command_buffers_ = vk::core::command_buffers( &command_pool_, frame_buffers_.get_count( ) );
+    if( draw_call.instance_count == 0 )
+        return;
 
-    record_commands( );
+    instanced_draw_calls_.push_back( draw_call );
 }
 
-void renderer::update( glm::mat4& model_matrix, glm::mat4& view_matrix, glm::mat4& projection_matrix )
+vk::helpers::memory_statistics renderer::get_memory_statistics( ) const
 {
-    uniform_buffers_.update( model_matrix, view_matrix, projection_matrix, image_index_ );
+    return memory_allocator_.get_statistics( );
 }
@@ -13,94 +13,275 @@
 #include "../vulkan/graphics/surface.h"
 #include "../vulkan/core/physical_device.h"
 #include "../vulkan/core/logical_device.h"
+#include "../vulkan/core/pipeline_cache.h"
 #include "../vulkan/core/command_pool.h"
+#include "../vulkan/core/memory_allocator.h"
+#include "../vulkan/core/upload_manager.h"
 #include "../vulkan/core/queue.h"
 #include "../vulkan/graphics/swapchain.h"
 #include "../vulkan/core/render_pass.h"
 #include "../vulkan/graphics/vertex.h"
 #include "../vulkan/graphics/graphics_pipeline.h"
+#include "../vulkan/graphics/pipeline_builder.h"
 #include "../vulkan/graphics/frame_buffers.h"
+#include "../vulkan/graphics/offscreen_target.h"
 #include "../vulkan/core/command_buffers.h"
-#include "../vulkan/core/fences.h"
+#include "../vulkan/core/frame_command_pool.h"
+#include "../vulkan/core/deletion_queue.h"
 #include "../vulkan/core/semaphores.h"
+#include "../vulkan/core/timeline_semaphore.h"
 #include "../vulkan/core/vertex_buffer.h"
 #include "../vulkan/core/index_buffer.h"
+#include "../vulkan/core/instance_buffer.h"
 #include "../vulkan/graphics/uniform_buffers.h"
+#include "../vulkan/graphics/draw_call.h"
+#include "../vulkan/graphics/parallel_recorder.h"
+#include "../vulkan/graphics/frame_context.h"
+#include "../vulkan/graphics/gpu_profiler.h"
+#include "../vulkan/graphics/object_data.h"
+#include "../vulkan/graphics/gpu_driven_scene.h"
 #include "../vulkan/core/descriptor_pool.h"
 #include "../vulkan/core/descriptor_sets.h"
 
 class renderer
 {
 public:
-    renderer( const window& window );
+    /*
+     * frames_in_flight, between 1 and 4, trades input latency for throughput. It can be changed
+     * later through set_frames_in_flight, which waits for the GPU to drain first.
+     */
+    renderer( const window& window, uint32_t frames_in_flight = 2,
+              const vk::graphics::swapchain_settings& swapchain_settings = { } );
+    /*
+     * Renders into offscreen images instead of a swapchain, without a window or surface, so it
+     * also runs on software implementations. Frames are never presented.
+     */
+    renderer( uint32_t width, uint32_t height, uint32_t frames_in_flight = 2 );
     ~renderer();
 
+    /*
+     * prepare_frame only waits until the next frame context is free, after which uniforms can be
+     * written. Draw calls can be queued at any time before submit_frame, which acquires the
+     * swapchain image, records and presents.
+     */
     void prepare_frame( );
     void submit_frame( );
 
+    void set_frames_in_flight( uint32_t frames_in_flight );
+
+    uint32_t get_frames_in_flight( ) const
+    {
+        return frames_in_flight_;
+    }
+
+    /*
+     * Both take effect from the next frame, the swapchain is rebuilt the same way as on a resize.
+     */
+    void set_present_policy( vk::graphics::present_policy policy );
+    void set_swapchain_image_count( uint32_t image_count );
+
+    VkPresentModeKHR get_present_mode( ) const
+    {
+        return swapchain_.get_present_mode();
+    }
+
+    /*
+     * Headless only. The next submitted frame is copied out once rendered, read_back waits for that
+     * copy and returns the RGBA8 pixels of the last requested frame, or false if no request is outstanding.
+     */
+    void request_readback( );
+    bool read_back( std::vector<uint8_t>& pixels );
+
+    bool is_headless( ) const
+    {
+        return is_headless_;
+    }
+
+    /*
+     * Timings of the most recently completed frame, frames in flight behind the one being recorded.
+     */
+    const vk::graphics::gpu_profiler& get_gpu_profiler( ) const
+    {
+        return gpu_profiler_;
+    }
+
+    /*
+     * GPU scopes are added to the writer while it is capturing. Null detaches it.
+     */
+    void set_trace_writer( trace_writer* p_trace_writer );
+
     void update( glm::mat4& model_matrix, glm::mat4& view_matrix, glm::mat4& projection_matrix );
+    void draw( const vk::graphics::draw_call& draw_call );
+    void draw_instanced( const vk::graphics::draw_call& draw_call );
 
     void create_pipeline( std::string&& vertex_shader, std::string&& fragment_shader );
+    void create_instanced_pipeline( std::string&& vertex_shader );
+
+    /*
+     * Queues a pipeline for compilation on the pipeline builder's workers. Draw calls using the
+     * returned id are drawn with the default pipeline until it is ready. Requesting the same
+     * shaders and state twice hands back the same id.
+     */
+    uint32_t request_pipeline( std::string&& vertex_shader, std::string&& fragment_shader,
+                               const vk::graphics::pipeline_state& state = { } );
     void prepare_for_rendering( const std::vector<vk::graphics::vertex>& vertices, const std::vector<std::uint16_t>& indices );
+    void prepare_gpu_driven_rendering( std::string&& vertex_shader, std::string&& cull_shader, uint32_t max_object_count );
+
+    /*
+     * False when the device lacks what prepare_gpu_driven_rendering requires.
+     */
+    bool is_gpu_driven_supported( ) const
+    {
+        return gpu_.get_supported_features().drawIndirectFirstInstance == VK_TRUE;
+    }
+
+    /*
+     * Swaps the mesh out at runtime, the previous buffers are retired until the frames using them are done.
+     */
+    void set_mesh( const std::vector<vk::graphics::vertex>& vertices, const std::vector<std::uint16_t>& indices );
+
+    /*
+     * An empty list clears the instance stream, instanced draws are skipped while there is none.
+     */
+    void set_instances( const std::vector<vk::graphics::instance_data>& instances );
+    /*
+     * Doesn't wait on frames in flight, they keep drawing the previous object list until they retire.
+     */
+    void set_objects( const std::vector<vk::graphics::object_data>& objects );
 
     void handle_event( event& e );
 
+    vk::helpers::memory_statistics get_memory_statistics( ) const;
+
+    const VkPhysicalDeviceProperties& get_device_properties( ) const
+    {
+        return gpu_.get_properties();
+    }
+
 private:
-    void recreate_swapchain( );
-    void record_commands( );
+    bool acquire_next_image( );
+    bool recreate_swapchain( uint32_t width, uint32_t height );
+    void recreate_render_pass( );
+    vk::core::command_buffers& record_commands( );
+    void replace_pipeline( const vk::graphics::pipeline_description& description, vk::graphics::pipeline_builder::pipeline_id& id,
+                           vk::graphics::graphics_pipeline*& p_pipeline );
+    vk::graphics::graphics_pipeline* wait_for_pipeline( vk::graphics::pipeline_builder::pipeline_id id );
+    void resolve_pipelines( );
+    void record_draw_calls( vk::core::command_buffers& command_buffers, uint32_t index, size_t first, size_t last );
+    void record_instanced_draw_calls( vk::core::command_buffers& command_buffers, uint32_t index );
+    void record_indirect_draws( vk::core::command_buffers& command_buffers, uint32_t index );
 
     void create_vertex_buffer( const std::vector<vk::graphics::vertex>& vertices );
     void create_index_buffer( const std::vector<std::uint16_t>& indices );
 
-    void handle_window_resizing();
+    void handle_window_resizing( event& e );
     void handle_frame_buffer_resizing( event& e );
+    void request_resize( uint32_t width, uint32_t height, bool is_frame_buffer_extent );
+
+    void create_frame_contexts( uint32_t frames_in_flight );
+
+    void create_device( );
+    void create_descriptors( );
+    void create_indirect_descriptor_set( );
+    void create_offscreen_target( uint32_t width, uint32_t height );
+
+    const VkExtent2D& get_extent( ) const;
 
 private:
     const std::vector<const char*> validation_layers = {
             "VK_LAYER_LUNARG_standard_validation"
     };
-    const std::vector<const char*> device_extensions = {
+    std::vector<const char*> device_extensions = {
             VK_KHR_SWAPCHAIN_EXTENSION_NAME
     };
 
 private:
-    const window& window_;
+    const window* p_window_ = nullptr;
+    bool is_headless_ = false;
 
     vk::core::instance              instance_;
     vk::core::debug_report          debug_report_;
     vk::graphics::surface           surface_;
     vk::core::physical_device       gpu_;
     vk::core::logical_device        logical_device_;
+    vk::core::pipeline_cache        pipeline_cache_;
     vk::core::queue                 graphics_queue_;
     vk::core::queue                 present_queue_;
-    vk::core::command_pool          command_pool_;
+    vk::core::memory_allocator      memory_allocator_;
+    vk::core::upload_manager        upload_manager_;
 
-    vk::core::semaphores            image_available_semaphores_;
-    vk::core::semaphores            render_finished_semaphores_;
-    vk::core::fences                fences_;
+    vk::core::timeline_semaphore    frame_timeline_;
 
     vk::core::descriptor_pool       descriptor_pool_;
     vk::core::descriptor_set_layout descriptor_set_layout_;
     vk::core::descriptor_sets       descriptor_sets_;
 
     vk::graphics::swapchain         swapchain_;
+    vk::graphics::swapchain_settings swapchain_settings_;
     vk::core::render_pass           render_pass_;
+    VkFormat                        render_pass_format_ = VK_FORMAT_UNDEFINED;
 
-    vk::graphics::graphics_pipeline graphics_pipeline_;
+    /*
+     * Every graphics pipeline comes from the builder, including the ones below. Slots never move,
+     * so the pointers stay valid across rebuilds. Replaced ones are released to deletion_queue_.
+     */
+    vk::graphics::pipeline_builder  pipeline_builder_;
+    vk::graphics::pipeline_builder::pipeline_id default_pipeline_id_ = 0;
+    vk::graphics::pipeline_builder::pipeline_id instanced_pipeline_id_ = 0;
+    vk::graphics::pipeline_builder::pipeline_id indirect_pipeline_id_ = 0;
+    vk::graphics::graphics_pipeline* p_default_pipeline_ = nullptr;
+    vk::graphics::graphics_pipeline* p_instanced_pipeline_ = nullptr;
+    vk::graphics::graphics_pipeline* p_indirect_pipeline_ = nullptr;
+    std::string                     fragment_shader_path_;
+    std::vector<VkPipeline>         resolved_pipelines_;
 
     vk::graphics::frame_buffers     frame_buffers_;
-    vk::core::command_buffers       command_buffers_;
+    vk::graphics::offscreen_target  offscreen_target_;
+    bool is_readback_requested_ = false;
+    uint64_t readback_value_ = 0;
 
-    // TODO: put them somewhere else.
-    vk::core::shader_module         vertex_shader_;
-    vk::core::shader_module         fragment_shader_;
+    /*
+     * Last known framebuffer size in pixels, what the swapchain is rebuilt to when the surface goes out of date.
+     */
+    VkExtent2D frame_buffer_extent_ = { 0, 0 };
+    VkExtent2D pending_extent_ = { 0, 0 };
+    bool is_resize_pending_ = false;
+    bool is_frame_buffer_extent_pending_ = false;
+    std::vector<vk::graphics::frame_context> frame_contexts_;
+    vk::graphics::parallel_recorder parallel_recorder_;
+    vk::graphics::gpu_profiler      gpu_profiler_;
+    trace_writer*                   p_trace_writer_ = nullptr;
 
     vk::core::vertex_buffer         vertex_buffer_;
     vk::core::index_buffer          index_buffer_;
+    vk::core::instance_buffer       instance_buffer_;
     vk::graphics::uniform_buffers   uniform_buffers_;
 
+    std::vector<vk::graphics::draw_call> draw_calls_;
+    std::vector<vk::graphics::draw_call> instanced_draw_calls_;
+    std::vector<VkCommandBuffer> secondary_command_buffers_;
+    uint32_t uniform_offset_ = 0;
+
+    bool is_instancing_ = false;
+
+    vk::core::descriptor_pool       indirect_descriptor_pool_;
+    vk::core::descriptor_set_layout indirect_descriptor_set_layout_;
+    vk::core::descriptor_sets       indirect_descriptor_sets_;
+    vk::graphics::gpu_driven_scene  gpu_driven_scene_;
+
+    glm::mat4 view_projection_ = glm::mat4( 1.0f );
+    bool is_gpu_driven_ = false;
+    bool has_draw_indirect_count_ = false;
+    bool has_timeline_semaphore_ = false;
+
+    vk::core::deletion_queue        deletion_queue_;
+
+    uint32_t frames_in_flight_ = 0;
     size_t current_frame_ = 0;
+    uint64_t frame_number_ = 0;
     uint32_t image_index_ = 0;
+
+    vk::core::upload_ticket upload_ticket_ = 0;
 };
 
 #endif //PROJEKT_RENDERER_H
@@ -0,0 +1,129 @@
+/*!
+ * @brief A fixed capacity ring for exactly one producer and one consumer
+ * thread. Neither side ever blocks or allocates, a push into a full ring
+ * is refused and counted instead.
+ */
+
+#ifndef PROJEKT_SPSC_RING_H
+#define PROJEKT_SPSC_RING_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+template<typename T, size_t capacity>
+class spsc_ring
+{
+    static_assert( capacity > 0 && ( capacity & ( capacity - 1 ) ) == 0, "spsc_ring capacity must be a power of two." );
+
+public:
+    spsc_ring( ) = default;
+    spsc_ring( const spsc_ring& spsc_ring ) = delete;
+
+    spsc_ring& operator=( const spsc_ring& spsc_ring ) = delete;
+
+    /*
+     * Producer only.
+     */
+    bool try_push( const T& value )
+    {
+        const auto head = head_.load( std::memory_order_relaxed );
+
+        /*
+         * The consumer's position is only reloaded once the ring looks full from the last
+         * known one, which keeps the producer off the consumer's cache line most of the time.
+         */
+        if( head - cached_tail_ == capacity )
+        {
+            cached_tail_ = tail_.load( std::memory_order_acquire );
+
+            if( head - cached_tail_ == capacity )
+            {
+                dropped_count_.fetch_add( 1, std::memory_order_relaxed );
+                return false;
+            }
+        }
+
+        slots_[head & MASK] = value;
+        head_.store( head + 1, std::memory_order_release );
+
+        return true;
+    }
+
+    /*
+     * Consumer only.
+     */
+    bool try_pop( T& value )
+    {
+        const auto tail = tail_.load( std::memory_order_relaxed );
+
+        if( tail == cached_head_ )
+        {
+            cached_head_ = head_.load( std::memory_order_acquire );
+
+            if( tail == cached_head_ )
+                return false;
+        }
+
+        value = slots_[tail & MASK];
+        tail_.store( tail + 1, std::memory_order_release );
+
+        return true;
+    }
+
+    /*
+     * Consumer only. Hands every element pushed so far to function, and frees their slots once it is done.
+     */
+    template<class function>
+    size_t pop_all( function&& f )
+    {
+        const auto tail = tail_.load( std::memory_order_relaxed );
+        cached_head_ = head_.load( std::memory_order_acquire );
+
+        for( auto i = tail; i != cached_head_; ++i )
+            f( slots_[i & MASK] );
+
+        tail_.store( cached_head_, std::memory_order_release );
+
+        return cached_head_ - tail;
+    }
+
+    /*
+     * Only a snapshot when called while the other side is active.
+     */
+    size_t size( ) const
+    {
+        return head_.load( std::memory_order_acquire ) - tail_.load( std::memory_order_acquire );
+    }
+
+    /*
+     * Pushes refused because the ring was full.
+     */
+    uint64_t get_dropped_count( ) const
+    {
+        return dropped_count_.load( std::memory_order_relaxed );
+    }
+
+    static constexpr size_t get_capacity( )
+    {
+        return capacity;
+    }
+
+private:
+    static constexpr size_t MASK = capacity - 1;
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+
+private:
+    alignas( CACHE_LINE_SIZE ) std::atomic<size_t> head_{ 0 };
+    size_t cached_tail_ = 0;
+
+    alignas( CACHE_LINE_SIZE ) std::atomic<size_t> tail_{ 0 };
+    size_t cached_head_ = 0;
+
+    alignas( CACHE_LINE_SIZE ) std::atomic<uint64_t> dropped_count_{ 0 };
+
+    std::array<T, capacity> slots_;
+};
+
+#endif //PROJEKT_SPSC_RING_H
@@ -0,0 +1,553 @@
+/*!
+ * @brief Scoped CPU zones that can be opened from any thread. Each thread
+ * writes its finished zones into its own single producer ring, which the
+ * thread calling end_frame drains without ever blocking the producers.
+ * Every frame the zones are merged into a call hierarchy, and frame and
+ * zone times are kept over a window of frames to report percentiles.
+ */
+
+#ifndef PROJEKT_CPU_PROFILER_H
+#define PROJEKT_CPU_PROFILER_H
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "trace_writer.h"
+#include "../containers/spsc_ring.h"
+#include "../file_io/write.h"
+
+class cpu_profiler
+{
+public:
+    using clock = std::chrono::steady_clock;
+
+    /*
+     * Zones have to be opened and closed on the same thread and must be string literals,
+     * or otherwise outlive the profiler, since only the pointer is kept.
+     */
+    class zone
+    {
+    public:
+        explicit zone( const char* name )
+        {
+            begin_zone( name );
+        }
+        zone( const zone& zone ) = delete;
+        ~zone( )
+        {
+            end_zone( );
+        }
+
+        zone& operator=( const zone& zone ) = delete;
+    };
+
+    struct percentiles
+    {
+        double p50 = 0.0;
+        double p95 = 0.0;
+        double p99 = 0.0;
+        double max = 0.0;
+
+        size_t sample_count = 0;
+    };
+
+    /*
+     * A node of the last frame's hierarchy. Repeated calls under the same parent are merged.
+     */
+    struct zone_timing
+    {
+        const char* name = "";
+
+        uint32_t track_id = 0;
+        uint32_t depth = 0;
+        uint32_t call_count = 0;
+
+        /*
+         * Total over all calls, in milliseconds.
+         */
+        double duration = 0.0;
+    };
+
+public:
+    static void begin_zone( const char* name )
+    {
+        auto& buffer = get_thread_buffer( );
+
+        if( buffer.depth < MAX_DEPTH )
+            buffer.open_zones[buffer.depth] = { name, clock::now() };
+
+        ++buffer.depth;
+    }
+    static void end_zone( )
+    {
+        auto& buffer = get_thread_buffer( );
+
+        if( buffer.depth == 0 )
+            return;
+
+        --buffer.depth;
+
+        if( buffer.depth >= MAX_DEPTH )
+            return;
+
+        const auto& open_zone = buffer.open_zones[buffer.depth];
+
+        buffer.records.try_push( { open_zone.name, buffer.depth, open_zone.start, clock::now() } );
+    }
+
+    /*
+     * Names the calling thread's track in traces.
+     */
+    static void set_thread_name( const std::string& name )
+    {
+        auto& buffer = get_thread_buffer( );
+        auto& state = get_state( );
+
+        std::lock_guard<std::mutex> lock( state.mutex );
+
+        buffer.name = name;
+
+        if( state.p_trace_writer )
+            state.p_trace_writer->set_track_name( buffer.track_id, buffer.name );
+    }
+
+    /*
+     * Zones of all threads are added to the writer while it is capturing. Null detaches it.
+     */
+    static void set_trace_writer( trace_writer* p_trace_writer )
+    {
+        auto& state = get_state( );
+
+        std::lock_guard<std::mutex> lock( state.mutex );
+
+        state.p_trace_writer = p_trace_writer;
+
+        if( state.p_trace_writer )
+        {
+            for( const auto& p_buffer : state.buffers )
+            {
+                if( !p_buffer->name.empty() )
+                    state.p_trace_writer->set_track_name( p_buffer->track_id, p_buffer->name );
+            }
+        }
+    }
+
+    /*
+     * Number of frames the percentiles are taken over. Clears the collected samples.
+     */
+    static void set_window_size( size_t frame_count )
+    {
+        auto& state = get_state( );
+
+        std::lock_guard<std::mutex> lock( state.mutex );
+
+        state.window_size = std::max<size_t>( frame_count, 1 );
+        state.frame_times = sample_window( state.window_size );
+        state.zone_times.clear();
+    }
+
+    /*
+     * Called once per frame from the thread driving the frame loop. The time between two calls
+     * is the frame time, and all zones finished since the previous call make up the frame.
+     */
+    static void end_frame( )
+    {
+        auto& state = get_state( );
+        const auto now = clock::now( );
+
+        std::lock_guard<std::mutex> lock( state.mutex );
+
+        if( state.frame_start != clock::time_point( ) )
+            state.frame_times.add( std::chrono::duration<double, std::milli>( now - state.frame_start ).count() );
+
+        state.frame_start = now;
+
+        collect( state );
+    }
+
+    static percentiles get_frame_percentiles( )
+    {
+        auto& state = get_state( );
+
+        std::lock_guard<std::mutex> lock( state.mutex );
+
+        return state.frame_times.compute();
+    }
+
+    /*
+     * Per frame totals of every zone with the given name, across all threads.
+     */
+    static percentiles get_zone_percentiles( const std::string& name )
+    {
+        auto& state = get_state( );
+
+        std::lock_guard<std::mutex> lock( state.mutex );
+
+        auto it = state.zone_times.find( name );
+        if( it == state.zone_times.end() )
+            return { };
+
+        return it->second.compute();
+    }
+
+    /*
+     * The last frame's hierarchy in depth first order, grouped by thread.
+     */
+    static std::vector<zone_timing> get_zones( )
+    {
+        auto& state = get_state( );
+
+        std::lock_guard<std::mutex> lock( state.mutex );
+
+        return state.zones;
+    }
+
+    /*
+     * Zones dropped because a thread's ring was full, ever since start up.
+     */
+    static uint64_t get_dropped_count( )
+    {
+        auto& state = get_state( );
+
+        std::lock_guard<std::mutex> lock( state.mutex );
+
+        uint64_t dropped = state.retired_dropped_count;
+        for( const auto& p_buffer : state.buffers )
+            dropped += p_buffer->records.get_dropped_count();
+
+        return dropped;
+    }
+
+    static std::string to_json( )
+    {
+        auto& state = get_state( );
+
+        std::lock_guard<std::mutex> lock( state.mutex );
+
+        std::ostringstream json;
+        json.precision( 3 );
+        json << std::fixed << "{\"frame_time\":";
+        write_percentiles( json, state.frame_times.compute() );
+
+        json << ",\"zone_times\":{";
+        bool is_first = true;
+        for( const auto& zone_time : state.zone_times )
+        {
+            json << ( is_first ? "" : "," ) << "\"" << zone_time.first << "\":";
+            write_percentiles( json, zone_time.second.compute() );
+
+            is_first = false;
+        }
+
+        json << "},\"last_frame\":[";
+        is_first = true;
+        for( const auto& zone : state.zones )
+        {
+            json << ( is_first ? "" : "," )
+                 << "{\"name\":\"" << zone.name << "\",\"track\":" << zone.track_id << ",\"depth\":" << zone.depth
+                 << ",\"calls\":" << zone.call_count << ",\"duration\":" << zone.duration << "}";
+
+            is_first = false;
+        }
+
+        json << "]}";
+
+        return json.str();
+    }
+
+    static void dump( const std::string& filepath )
+    {
+        write_to_file( filepath, to_json() );
+    }
+
+private:
+    static constexpr uint32_t MAX_DEPTH = 32;
+    static constexpr size_t RING_CAPACITY = 4096;
+    static constexpr size_t DEFAULT_WINDOW_SIZE = 1000;
+
+    struct zone_record
+    {
+        const char* name;
+        uint32_t depth;
+        clock::time_point start;
+        clock::time_point end;
+    };
+
+    struct open_zone
+    {
+        const char* name;
+        clock::time_point start;
+    };
+
+    /*
+     * Only the owning thread pushes and only end_frame pops. A full ring drops the zone rather than waiting.
+     */
+    struct thread_buffer
+    {
+        uint32_t track_id = 0;
+        std::string name;
+
+        std::array<open_zone, MAX_DEPTH> open_zones;
+        uint32_t depth = 0;
+
+        spsc_ring<zone_record, RING_CAPACITY> records;
+    };
+
+    class sample_window
+    {
+    public:
+        explicit sample_window( size_t capacity = DEFAULT_WINDOW_SIZE )
+            :
+            capacity_( capacity )
+        {
+            samples_.reserve( capacity_ );
+        }
+
+        void add( double sample )
+        {
+            if( samples_.size() < capacity_ )
+                samples_.push_back( sample );
+            else
+                samples_[next_] = sample;
+
+            next_ = ( next_ + 1 ) % capacity_;
+        }
+
+        /*
+         * Nearest rank percentiles, exact over the window.
+         */
+        percentiles compute( ) const
+        {
+            percentiles result = {};
+            result.sample_count = samples_.size();
+
+            if( samples_.empty() )
+                return result;
+
+            sorted_ = samples_;
+            std::sort( sorted_.begin(), sorted_.end() );
+
+            auto rank = [this]( double p )
+            {
+                auto i = static_cast<size_t>( std::ceil( p * sorted_.size() ) );
+                return sorted_[std::max<size_t>( i, 1 ) - 1];
+            };
+
+            result.p50 = rank( 0.50 );
+            result.p95 = rank( 0.95 );
+            result.p99 = rank( 0.99 );
+            result.max = sorted_.back();
+
+            return result;
+        }
+
+    private:
+        std::vector<double> samples_;
+        mutable std::vector<double> sorted_;
+
+        size_t capacity_;
+        size_t next_ = 0;
+    };
+
+    struct zone_node
+    {
+        const char* name;
+        uint32_t depth;
+        double duration;
+        uint32_t call_count;
+        std::vector<size_t> children;
+    };
+
+    struct state
+    {
+        std::mutex mutex;
+
+        std::vector<std::shared_ptr<thread_buffer>> buffers;
+        uint32_t next_track_id = 1;
+        uint64_t retired_dropped_count = 0;
+
+        clock::time_point frame_start;
+        size_t window_size = DEFAULT_WINDOW_SIZE;
+        sample_window frame_times;
+        std::unordered_map<std::string, sample_window> zone_times;
+        std::unordered_map<std::string, double> frame_zone_totals;
+
+        std::vector<zone_record> records;
+        std::vector<zone_node> nodes;
+        std::vector<size_t> roots;
+        std::vector<std::pair<uint32_t, size_t>> parents;
+        std::vector<zone_timing> zones;
+
+        trace_writer* p_trace_writer = nullptr;
+    };
+
+private:
+    static state& get_state( )
+    {
+        static state s;
+
+        return s;
+    }
+
+    static thread_buffer& get_thread_buffer( )
+    {
+        thread_local std::shared_ptr<thread_buffer> p_buffer;
+
+        if( !p_buffer )
+        {
+            auto& state = get_state( );
+
+            p_buffer = std::make_shared<thread_buffer>( );
+
+            std::lock_guard<std::mutex> lock( state.mutex );
+
+            p_buffer->track_id = state.next_track_id++;
+            state.buffers.push_back( p_buffer );
+        }
+
+        return *p_buffer;
+    }
+
+    static void collect( state& state )
+    {
+        state.zones.clear();
+        state.frame_zone_totals.clear();
+
+        const bool is_tracing = state.p_trace_writer && state.p_trace_writer->is_capturing();
+
+        for( auto& p_buffer : state.buffers )
+        {
+            state.records.clear();
+            p_buffer->records.pop_all( [&state]( const zone_record& record ) { state.records.push_back( record ); } );
+
+            if( state.records.empty() )
+                continue;
+
+            /*
+             * Zones are pushed as they end, children before their parent. Sorted by start a
+             * parent comes first, and its children follow before any of its later siblings.
+             */
+            std::sort( state.records.begin(), state.records.end(), []( const zone_record& lhs, const zone_record& rhs )
+            {
+                return lhs.start < rhs.start || ( lhs.start == rhs.start && lhs.depth < rhs.depth );
+            } );
+
+            state.nodes.clear();
+            state.roots.clear();
+            state.parents.clear();
+
+            for( const auto& record : state.records )
+            {
+                const double duration = std::chrono::duration<double, std::milli>( record.end - record.start ).count();
+
+                /*
+                 * The parent is the closest enclosing zone seen this frame. A zone whose parent is still
+                 * open, or ended before the ring was last drained, becomes a root.
+                 */
+                while( !state.parents.empty() && state.parents.back().first >= record.depth )
+                    state.parents.pop_back();
+
+                auto& siblings = state.parents.empty() ? state.roots : state.nodes[state.parents.back().second].children;
+
+                auto it = std::find_if( siblings.begin(), siblings.end(), [&state, &record]( size_t i )
+                {
+                    return std::strcmp( state.nodes[i].name, record.name ) == 0;
+                } );
+
+                size_t node_index;
+                if( it != siblings.end() )
+                {
+                    node_index = *it;
+                }
+                else
+                {
+                    node_index = state.nodes.size();
+                    siblings.push_back( node_index );
+                    state.nodes.push_back( { record.name, static_cast<uint32_t>( state.parents.size() ), 0.0, 0, { } } );
+                }
+
+                state.nodes[node_index].duration += duration;
+                state.nodes[node_index].call_count += 1;
+
+                state.parents.emplace_back( record.depth, node_index );
+
+                state.frame_zone_totals[record.name] += duration;
+
+                if( is_tracing )
+                {
+                    trace_event event = {};
+                    event.name = record.name;
+                    event.category = "cpu";
+                    event.track_id = p_buffer->track_id;
+                    event.start_us = state.p_trace_writer->to_microseconds( record.start );
+                    event.duration_us = std::chrono::duration<double, std::micro>( record.end - record.start ).count();
+
+                    state.p_trace_writer->add_event( std::move( event ) );
+                }
+            }
+
+            for( auto root : state.roots )
+                flatten( state, root, p_buffer->track_id );
+        }
+
+        for( const auto& total : state.frame_zone_totals )
+        {
+            auto it = state.zone_times.find( total.first );
+            if( it == state.zone_times.end() )
+                it = state.zone_times.emplace( total.first, sample_window( state.window_size ) ).first;
+
+            it->second.add( total.second );
+        }
+
+        /*
+         * Buffers of threads that have exited are only held here, drop them once drained.
+         */
+        for( auto it = state.buffers.begin(); it != state.buffers.end(); )
+        {
+            if( it->use_count() == 1 )
+            {
+                state.retired_dropped_count += ( *it )->records.get_dropped_count();
+                it = state.buffers.erase( it );
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    static void flatten( state& state, size_t node_index, uint32_t track_id )
+    {
+        const auto& node = state.nodes[node_index];
+
+        zone_timing timing = {};
+        timing.name = node.name;
+        timing.track_id = track_id;
+        timing.depth = node.depth;
+        timing.call_count = node.call_count;
+        timing.duration = node.duration;
+
+        state.zones.push_back( timing );
+
+        for( auto child : node.children )
+            flatten( state, child, track_id );
+    }
+
+    static void write_percentiles( std::ostringstream& json, const percentiles& p )
+    {
+        json << "{\"p50\":" << p.p50 << ",\"p95\":" << p.p95 << ",\"p99\":" << p.p99 << ",\"max\":" << p.max
+             << ",\"samples\":" << p.sample_count << "}";
+    }
+};
+
+#endif //PROJEKT_CPU_PROFILER_H
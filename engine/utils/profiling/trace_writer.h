@@ -0,0 +1,163 @@
+/*!
+ * @brief Collects timed events from the CPU and GPU profilers and writes
+ * them out in the Chrome trace_event JSON format, to be opened in
+ * chrome://tracing or Perfetto. Events are only kept while capturing.
+ */
+
+#ifndef PROJEKT_TRACE_WRITER_H
+#define PROJEKT_TRACE_WRITER_H
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../file_io/write.h"
+
+struct trace_event
+{
+    std::string name;
+    const char* category = "";
+
+    /*
+     * Events with the same track id are drawn on the same row, nested by time.
+     */
+    uint32_t track_id = 0;
+
+    double start_us = 0.0;
+    double duration_us = 0.0;
+};
+
+class trace_writer
+{
+public:
+    using clock = std::chrono::steady_clock;
+
+public:
+    trace_writer( )
+        :
+        epoch_( clock::now() )
+    {
+    }
+
+    void begin_capture( )
+    {
+        std::lock_guard<std::mutex> lock( mutex_ );
+
+        events_.clear();
+        is_capturing_ = true;
+    }
+    void end_capture( )
+    {
+        std::lock_guard<std::mutex> lock( mutex_ );
+
+        is_capturing_ = false;
+    }
+
+    bool is_capturing( ) const
+    {
+        std::lock_guard<std::mutex> lock( mutex_ );
+
+        return is_capturing_;
+    }
+
+    void set_track_name( uint32_t track_id, const std::string& name )
+    {
+        std::lock_guard<std::mutex> lock( mutex_ );
+
+        track_names_[track_id] = name;
+    }
+
+    void add_event( trace_event&& event )
+    {
+        std::lock_guard<std::mutex> lock( mutex_ );
+
+        if( is_capturing_ )
+            events_.emplace_back( std::move( event ) );
+    }
+
+    /*
+     * Microseconds since the writer was created, the time base of every event.
+     */
+    double to_microseconds( clock::time_point time_point ) const
+    {
+        return std::chrono::duration<double, std::micro>( time_point - epoch_ ).count();
+    }
+
+    size_t get_event_count( ) const
+    {
+        std::lock_guard<std::mutex> lock( mutex_ );
+
+        return events_.size();
+    }
+
+    std::string to_json( ) const
+    {
+        std::lock_guard<std::mutex> lock( mutex_ );
+
+        std::ostringstream json;
+        json.precision( 3 );
+        json << std::fixed << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+        bool is_first = true;
+        for( const auto& track_name : track_names_ )
+        {
+            json << ( is_first ? "" : "," )
+                 << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << track_name.first
+                 << ",\"args\":{\"name\":\"" << escape( track_name.second ) << "\"}}";
+
+            is_first = false;
+        }
+
+        for( const auto& event : events_ )
+        {
+            json << ( is_first ? "" : "," )
+                 << "{\"name\":\"" << escape( event.name ) << "\",\"cat\":\"" << escape( event.category )
+                 << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.track_id
+                 << ",\"ts\":" << event.start_us << ",\"dur\":" << event.duration_us << "}";
+
+            is_first = false;
+        }
+
+        json << "]}";
+
+        return json.str();
+    }
+
+    void write( const std::string& filepath ) const
+    {
+        write_to_file( filepath, to_json() );
+    }
+
+private:
+    static std::string escape( const std::string& str )
+    {
+        std::string escaped;
+        escaped.reserve( str.size() );
+
+        for( auto c : str )
+        {
+            if( c == '"' || c == '\\' )
+                escaped += '\\';
+
+            if( static_cast<unsigned char>( c ) >= 0x20 )
+                escaped += c;
+        }
+
+        return escaped;
+    }
+
+private:
+    clock::time_point epoch_;
+
+    mutable std::mutex mutex_;
+
+    std::vector<trace_event> events_;
+    std::map<uint32_t, std::string> track_names_;
+    bool is_capturing_ = false;
+};
+
+#endif //PROJEKT_TRACE_WRITER_H
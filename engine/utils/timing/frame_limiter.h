@@ -0,0 +1,81 @@
+/*!
+ * @brief Caps the frame rate by holding the calling thread until the next
+ * frame is due. Most of the wait is slept, the last stretch is spun since
+ * the OS scheduler can't be trusted to wake up on time.
+ */
+
+#ifndef PROJEKT_FRAME_LIMITER_H
+#define PROJEKT_FRAME_LIMITER_H
+
+#include <chrono>
+#include <thread>
+
+class frame_limiter
+{
+public:
+    using clock = std::chrono::steady_clock;
+
+public:
+    /*
+     * A target of 0 leaves the frame rate uncapped.
+     */
+    explicit frame_limiter( double target_fps = 0.0,
+                            std::chrono::microseconds spin_threshold = std::chrono::microseconds( 2000 ) )
+        :
+        spin_threshold_( spin_threshold )
+    {
+        set_target_fps( target_fps );
+    }
+
+    void set_target_fps( double target_fps )
+    {
+        target_fps_ = target_fps;
+
+        if( target_fps_ > 0.0 )
+            frame_duration_ = std::chrono::duration_cast<clock::duration>( std::chrono::duration<double>( 1.0 / target_fps_ ) );
+        else
+            frame_duration_ = clock::duration::zero();
+
+        next_frame_ = clock::now() + frame_duration_;
+    }
+
+    double get_target_fps( ) const
+    {
+        return target_fps_;
+    }
+
+    void wait( )
+    {
+        if( frame_duration_ == clock::duration::zero() )
+            return;
+
+        auto now = clock::now();
+
+        /*
+         * A frame that ran over the budget restarts the schedule instead of letting the
+         * following frames rush to catch up.
+         */
+        if( now > next_frame_ )
+        {
+            next_frame_ = now + frame_duration_;
+            return;
+        }
+
+        if( next_frame_ - now > spin_threshold_ )
+            std::this_thread::sleep_for( next_frame_ - now - spin_threshold_ );
+
+        while( clock::now() < next_frame_ )
+            std::this_thread::yield();
+
+        next_frame_ += frame_duration_;
+    }
+
+private:
+    double target_fps_ = 0.0;
+
+    clock::duration frame_duration_ = clock::duration::zero();
+    clock::duration spin_threshold_;
+    clock::time_point next_frame_;
+};
+
+#endif //PROJEKT_FRAME_LIMITER_H
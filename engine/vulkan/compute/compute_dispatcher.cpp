@@ -0,0 +1,79 @@
+/*!
+ *
+ */
+
+#include "compute_dispatcher.h"
+
+namespace vk
+{
+    namespace compute
+    {
+        compute_dispatcher::compute_dispatcher( const core::physical_device& physical_device, const core::logical_device* p_logical_device )
+            :
+            command_pool_( physical_device, p_logical_device, helpers::queue_family_type::e_compute ),
+            compute_queue_( *p_logical_device, physical_device, helpers::queue_family_type::e_compute, 0 ),
+            timeline_( p_logical_device )
+        {
+        }
+        compute_dispatcher::compute_dispatcher( compute_dispatcher&& compute_dispatcher ) noexcept
+        {
+            *this = std::move( compute_dispatcher );
+        }
+        compute_dispatcher::~compute_dispatcher( )
+        {
+            wait( );
+        }
+
+        uint64_t
+        compute_dispatcher::submit( const record_function& function, const std::vector<core::timeline_wait>& waits )
+        {
+            wait( );
+
+            command_pool_.reset( );
+
+            auto& command_buffer = command_pool_.acquire( VK_COMMAND_BUFFER_LEVEL_PRIMARY );
+
+            command_buffer.begin( VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT, 0 );
+            function( command_buffer, 0 );
+            command_buffer.end( 0 );
+
+            VkSubmitInfo submit_info = {};
+            submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+            submit_info.commandBufferCount = 1;
+            submit_info.pCommandBuffers = &command_buffer[0];
+
+            last_value_ = timeline_.submit( compute_queue_, submit_info, waits );
+
+            return last_value_;
+        }
+
+        bool
+        compute_dispatcher::is_complete( )
+        {
+            return timeline_.is_complete( last_value_ );
+        }
+        void
+        compute_dispatcher::wait( )
+        {
+            timeline_.wait( last_value_ );
+        }
+
+        compute_dispatcher&
+        compute_dispatcher::operator=( compute_dispatcher&& compute_dispatcher ) noexcept
+        {
+            if( this != &compute_dispatcher )
+            {
+                wait( );
+
+                command_pool_ = std::move( compute_dispatcher.command_pool_ );
+                compute_queue_ = std::move( compute_dispatcher.compute_queue_ );
+                timeline_ = std::move( compute_dispatcher.timeline_ );
+
+                last_value_ = compute_dispatcher.last_value_;
+                compute_dispatcher.last_value_ = 0;
+            }
+
+            return *this;
+        }
+    }
+}
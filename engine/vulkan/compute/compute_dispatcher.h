@@ -0,0 +1,61 @@
+/*!
+ * @brief Runs compute work on the compute queue without going through the
+ * renderer. One submission is kept in flight at a time, each one signals
+ * the next value of the dispatcher's timeline so graphics work can chain
+ * on it, and it may itself wait on values of other timelines.
+ */
+
+#ifndef PROJEKT_COMPUTE_DISPATCHER_H
+#define PROJEKT_COMPUTE_DISPATCHER_H
+
+#include <functional>
+
+#include <vulkan/vulkan.h>
+
+#include "../core/physical_device.h"
+#include "../core/logical_device.h"
+#include "../core/command_buffers.h"
+#include "../core/frame_command_pool.h"
+#include "../core/queue.h"
+#include "../core/timeline_semaphore.h"
+
+namespace vk
+{
+    namespace compute
+    {
+        class compute_dispatcher
+        {
+        public:
+            using record_function = std::function<void( core::command_buffers& command_buffers, uint32_t index )>;
+
+        public:
+            compute_dispatcher( ) = default;
+            compute_dispatcher( const core::physical_device& physical_device, const core::logical_device* p_logical_device );
+            compute_dispatcher( const compute_dispatcher& compute_dispatcher ) = delete;
+            compute_dispatcher( compute_dispatcher&& compute_dispatcher ) noexcept;
+            ~compute_dispatcher( );
+
+            uint64_t submit( const record_function& function, const std::vector<core::timeline_wait>& waits = { } );
+
+            bool is_complete( );
+            void wait( );
+
+            core::timeline_semaphore& get_timeline( )
+            {
+                return timeline_;
+            }
+
+            compute_dispatcher& operator=( const compute_dispatcher& compute_dispatcher ) = delete;
+            compute_dispatcher& operator=( compute_dispatcher&& compute_dispatcher ) noexcept;
+
+        private:
+            core::frame_command_pool command_pool_;
+            core::queue compute_queue_;
+            core::timeline_semaphore timeline_;
+
+            uint64_t last_value_ = 0;
+        };
+    }
+}
+
+#endif //PROJEKT_COMPUTE_DISPATCHER_H
@@ -0,0 +1,115 @@
+/*!
+ *
+ */
+
+#include "compute_kernel.h"
+#include "../../utils/exception/vulkan_exception.h"
+
+namespace vk
+{
+    namespace compute
+    {
+        compute_kernel::compute_kernel( const core::logical_device* p_logical_device, const core::pipeline_cache& pipeline_cache,
+                                        const std::string& shader_path,
+                                        uint32_t storage_buffer_count, uint32_t push_constant_size )
+            :
+            p_logical_device_( p_logical_device ),
+            storage_buffer_count_( storage_buffer_count ),
+            push_constant_size_( push_constant_size )
+        {
+            std::vector<VkDescriptorSetLayoutBinding> bindings( storage_buffer_count_ );
+            for( uint32_t i = 0; i < storage_buffer_count_; ++i )
+            {
+                bindings[i].binding = i;
+                bindings[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+                bindings[i].descriptorCount = 1;
+                bindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+            }
+
+            compute_shader_ = core::shader_module( p_logical_device_, shader_path );
+            descriptor_set_layout_ = core::descriptor_set_layout( p_logical_device_, bindings );
+
+            create_descriptor_set( );
+
+            compute_pipeline_ = core::compute_pipeline( p_logical_device_, pipeline_cache, descriptor_set_layout_, compute_shader_, push_constant_size_ );
+        }
+        compute_kernel::compute_kernel( compute_kernel&& compute_kernel ) noexcept
+        {
+            *this = std::move( compute_kernel );
+        }
+
+        void
+        compute_kernel::bind( const std::vector<VkDescriptorBufferInfo>& storage_buffers )
+        {
+            if( storage_buffers.size() != storage_buffer_count_ )
+                throw vulkan_exception{ "Storage buffer count does not match the compute kernel layout.", __FILE__, __LINE__ };
+
+            descriptor_sets_.update( *p_logical_device_, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, storage_buffers, 0 );
+        }
+        void
+        compute_kernel::bind( const std::vector<VkDescriptorBufferInfo>& storage_buffers, core::deletion_queue& deletion_queue )
+        {
+            /*
+             * Destroying the pool frees the set allocated from it.
+             */
+            deletion_queue.retire( std::move( descriptor_pool_ ) );
+
+            create_descriptor_set( );
+
+            bind( storage_buffers );
+        }
+
+        void
+        compute_kernel::record( core::command_buffers& command_buffers, uint32_t index,
+                                uint32_t group_count_x, uint32_t group_count_y, uint32_t group_count_z,
+                                const void* p_push_constants )
+        {
+            command_buffers.bind_pipeline( VK_PIPELINE_BIND_POINT_COMPUTE, compute_pipeline_.get(), index );
+            command_buffers.bind_descriptor_sets( VK_PIPELINE_BIND_POINT_COMPUTE, compute_pipeline_.get_layout(), 0, 1,
+                                                  &descriptor_sets_[0], 0, nullptr, index );
+
+            if( p_push_constants != nullptr && push_constant_size_ > 0 )
+            {
+                command_buffers.push_constants( compute_pipeline_.get_layout(), VK_SHADER_STAGE_COMPUTE_BIT,
+                                                0, push_constant_size_, p_push_constants, index );
+            }
+
+            command_buffers.dispatch( group_count_x, group_count_y, group_count_z, index );
+        }
+
+        void
+        compute_kernel::create_descriptor_set( )
+        {
+            VkDescriptorPoolSize pool_size = {};
+            pool_size.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            pool_size.descriptorCount = storage_buffer_count_;
+
+            descriptor_pool_ = core::descriptor_pool( p_logical_device_, { pool_size }, 1 );
+            descriptor_sets_ = core::descriptor_sets( *p_logical_device_, &descriptor_pool_, descriptor_set_layout_,
+                                                      VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, { } );
+        }
+
+        compute_kernel&
+        compute_kernel::operator=( compute_kernel&& compute_kernel ) noexcept
+        {
+            if( this != &compute_kernel )
+            {
+                compute_pipeline_ = std::move( compute_kernel.compute_pipeline_ );
+                descriptor_sets_ = std::move( compute_kernel.descriptor_sets_ );
+                descriptor_pool_ = std::move( compute_kernel.descriptor_pool_ );
+                descriptor_set_layout_ = std::move( compute_kernel.descriptor_set_layout_ );
+                compute_shader_ = std::move( compute_kernel.compute_shader_ );
+
+                storage_buffer_count_ = compute_kernel.storage_buffer_count_;
+                compute_kernel.storage_buffer_count_ = 0;
+
+                push_constant_size_ = compute_kernel.push_constant_size_;
+                compute_kernel.push_constant_size_ = 0;
+
+                p_logical_device_ = compute_kernel.p_logical_device_;
+            }
+
+            return *this;
+        }
+    }
+}
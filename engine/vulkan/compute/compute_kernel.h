@@ -0,0 +1,72 @@
+/*!
+ * @brief A compute shader together with the pipeline and descriptor set
+ * needed to run it over a fixed number of storage buffers. Dispatches are
+ * recorded into any command buffer, so the kernel can run on its own
+ * through a compute_dispatcher or inside a frame next to the draws.
+ */
+
+#ifndef PROJEKT_COMPUTE_KERNEL_H
+#define PROJEKT_COMPUTE_KERNEL_H
+
+#include <string>
+#include <vector>
+
+#include <vulkan/vulkan.h>
+
+#include "../core/logical_device.h"
+#include "../core/shader_module.h"
+#include "../core/descriptor_set_layout.h"
+#include "../core/descriptor_pool.h"
+#include "../core/descriptor_sets.h"
+#include "../core/compute_pipeline.h"
+#include "../core/command_buffers.h"
+#include "../core/deletion_queue.h"
+
+namespace vk
+{
+    namespace compute
+    {
+        class compute_kernel
+        {
+        public:
+            compute_kernel( ) = default;
+            compute_kernel( const core::logical_device* p_logical_device, const core::pipeline_cache& pipeline_cache,
+                            const std::string& shader_path,
+                            uint32_t storage_buffer_count, uint32_t push_constant_size = 0 );
+            compute_kernel( const compute_kernel& compute_kernel ) = delete;
+            compute_kernel( compute_kernel&& compute_kernel ) noexcept;
+            ~compute_kernel( ) = default;
+
+            void bind( const std::vector<VkDescriptorBufferInfo>& storage_buffers );
+            /*
+             * Binds through a fresh descriptor set, retiring the current one, for when dispatches
+             * already submitted may still be reading it.
+             */
+            void bind( const std::vector<VkDescriptorBufferInfo>& storage_buffers, core::deletion_queue& deletion_queue );
+
+            void record( core::command_buffers& command_buffers, uint32_t index,
+                         uint32_t group_count_x, uint32_t group_count_y, uint32_t group_count_z,
+                         const void* p_push_constants = nullptr );
+
+            compute_kernel& operator=( const compute_kernel& compute_kernel ) = delete;
+            compute_kernel& operator=( compute_kernel&& compute_kernel ) noexcept;
+
+        private:
+            void create_descriptor_set( );
+
+        private:
+            const core::logical_device* p_logical_device_ = nullptr;
+
+            core::shader_module compute_shader_;
+            core::descriptor_set_layout descriptor_set_layout_;
+            core::descriptor_pool descriptor_pool_;
+            core::descriptor_sets descriptor_sets_;
+            core::compute_pipeline compute_pipeline_;
+
+            uint32_t storage_buffer_count_ = 0;
+            uint32_t push_constant_size_ = 0;
+        };
+    }
+}
+
+#endif //PROJEKT_COMPUTE_KERNEL_H
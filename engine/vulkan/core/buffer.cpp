@@ -0,0 +1,78 @@
+/*!
+ *
+ */
+
+#include "buffer.h"
+
+namespace vk
+{
+    namespace core
+    {
+        buffer::buffer( const logical_device* p_logical_device, memory_allocator* p_memory_allocator,
+                        VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties,
+                        const std::vector<uint32_t>& queue_family_indices )
+            :
+            p_logical_device_( p_logical_device ),
+            p_memory_allocator_( p_memory_allocator ),
+            size_( size )
+        {
+            VkBufferCreateInfo create_info = {};
+            create_info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+            create_info.size = size_;
+            create_info.usage = usage;
+
+            if( queue_family_indices.size() > 1 )
+            {
+                create_info.sharingMode = VK_SHARING_MODE_CONCURRENT;
+                create_info.queueFamilyIndexCount = static_cast<uint32_t>( queue_family_indices.size() );
+                create_info.pQueueFamilyIndices = queue_family_indices.data();
+            }
+            else
+            {
+                create_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+            }
+
+            buffer_handle_ = p_logical_device_->create_buffer( create_info );
+            allocation_ = p_memory_allocator_->allocate_buffer_memory( buffer_handle_, properties );
+        }
+        buffer::buffer( buffer&& buffer ) noexcept
+        {
+            *this = std::move( buffer );
+        }
+        buffer::~buffer( )
+        {
+            if( buffer_handle_ != VK_NULL_HANDLE )
+                buffer_handle_ = p_logical_device_->destroy_buffer( buffer_handle_ );
+
+            if( allocation_.memory_handle != VK_NULL_HANDLE )
+                p_memory_allocator_->free( allocation_ );
+        }
+
+        buffer&
+        buffer::operator=( buffer&& buffer ) noexcept
+        {
+            if( this != &buffer )
+            {
+                if( buffer_handle_ != VK_NULL_HANDLE )
+                    buffer_handle_ = p_logical_device_->destroy_buffer( buffer_handle_ );
+
+                if( allocation_.memory_handle != VK_NULL_HANDLE )
+                    p_memory_allocator_->free( allocation_ );
+
+                buffer_handle_ = buffer.buffer_handle_;
+                buffer.buffer_handle_ = VK_NULL_HANDLE;
+
+                allocation_ = buffer.allocation_;
+                buffer.allocation_ = {};
+
+                size_ = buffer.size_;
+                buffer.size_ = 0;
+
+                p_logical_device_ = buffer.p_logical_device_;
+                p_memory_allocator_ = buffer.p_memory_allocator_;
+            }
+
+            return *this;
+        }
+    }
+}
@@ -0,0 +1,60 @@
+/*!
+ *
+ */
+
+#ifndef PROJEKT_BUFFER_H
+#define PROJEKT_BUFFER_H
+
+#include <vector>
+
+#include <vulkan/vulkan.h>
+
+#include "logical_device.h"
+#include "memory_allocator.h"
+
+namespace vk
+{
+    namespace core
+    {
+        class buffer
+        {
+        public:
+            buffer( ) = default;
+            buffer( const logical_device* p_logical_device, memory_allocator* p_memory_allocator,
+                    VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties,
+                    const std::vector<uint32_t>& queue_family_indices = { } );
+            buffer( const buffer& buffer ) = delete;
+            buffer( buffer&& buffer ) noexcept;
+            ~buffer( );
+
+            VkBuffer& get()
+            {
+                return buffer_handle_;
+            }
+
+            VkDeviceSize get_size() const
+            {
+                return size_;
+            }
+
+            void* get_mapped_data() const
+            {
+                return allocation_.p_mapped_data;
+            }
+
+            buffer& operator=( const buffer& buffer ) = delete;
+            buffer& operator=( buffer&& buffer ) noexcept;
+
+        private:
+            const logical_device* p_logical_device_ = nullptr;
+            memory_allocator* p_memory_allocator_ = nullptr;
+
+            VkBuffer buffer_handle_ = VK_NULL_HANDLE;
+            helpers::memory_allocation allocation_ = {};
+
+            VkDeviceSize size_ = 0;
+        };
+    }
+}
+
+#endif //PROJEKT_BUFFER_H
@@ -9,14 +9,14 @@ namespace vk
 {
     namespace core
     {
-        command_buffers::command_buffers( const command_pool* p_command_pool, size_t count )
+        command_buffers::command_buffers( const command_pool* p_command_pool, size_t count, VkCommandBufferLevel level )
                 :
                 p_command_pool_( p_command_pool ),
                 count_( count )
         {
             VkCommandBufferAllocateInfo allocate_info = {};
             allocate_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-            allocate_info.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+            allocate_info.level = level;
             allocate_info.commandBufferCount = static_cast<uint32_t>( count_ );
 
             command_buffer_handles_ = p_command_pool_->allocate_command_buffers( allocate_info, count_ );
@@ -68,6 +68,17 @@ namespace vk
                 throw vulkan_exception{ "Failed to begin recording Command Buffer.", __FILE__, __LINE__ };
         }
         void
+        command_buffers::begin( VkCommandBufferUsageFlags flags, const VkCommandBufferInheritanceInfo& inheritance_info, uint32_t index )
+        {
+            VkCommandBufferBeginInfo command_buffer_begin_info = {};
+            command_buffer_begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+            command_buffer_begin_info.flags = flags;
+            command_buffer_begin_info.pInheritanceInfo = &inheritance_info;
+
+            if( vkBeginCommandBuffer( command_buffer_handles_[index], &command_buffer_begin_info ) != VK_SUCCESS )
+                throw vulkan_exception{ "Failed to begin recording Command Buffer.", __FILE__, __LINE__ };
+        }
+        void
         command_buffers::end( uint32_t index )
         {
             if( vkEndCommandBuffer( command_buffer_handles_[index] ) != VK_SUCCESS )
@@ -85,6 +96,11 @@ namespace vk
             vkCmdEndRenderPass( command_buffer_handles_[index] );
 
         }
+        void
+        command_buffers::execute_commands( uint32_t command_buffer_count, const VkCommandBuffer* p_command_buffers, uint32_t index )
+        {
+            vkCmdExecuteCommands( command_buffer_handles_[index], command_buffer_count, p_command_buffers );
+        }
 
         void
         command_buffers::bind_descriptor_sets( VkPipelineBindPoint pipeline_bind_point,
@@ -122,6 +138,71 @@ namespace vk
         {
             vkCmdDrawIndexed( command_buffer_handles_[index], index_count, instance_count, first_index, vertex_offset, first_instance );
         }
+        void
+        command_buffers::draw_indexed_indirect( VkBuffer& buffer, VkDeviceSize offset, uint32_t draw_count, uint32_t stride, uint32_t index )
+        {
+            vkCmdDrawIndexedIndirect( command_buffer_handles_[index], buffer, offset, draw_count, stride );
+        }
+        void
+        command_buffers::draw_indexed_indirect_count( PFN_vkCmdDrawIndexedIndirectCountKHR p_function, VkBuffer& buffer, VkDeviceSize offset,
+                                                      VkBuffer& count_buffer, VkDeviceSize count_buffer_offset,
+                                                      uint32_t max_draw_count, uint32_t stride, uint32_t index )
+        {
+            p_function( command_buffer_handles_[index], buffer, offset, count_buffer, count_buffer_offset, max_draw_count, stride );
+        }
+
+        void
+        command_buffers::fill_buffer( VkBuffer& buffer, VkDeviceSize offset, VkDeviceSize size, uint32_t data, uint32_t index )
+        {
+            vkCmdFillBuffer( command_buffer_handles_[index], buffer, offset, size, data );
+        }
+
+        void
+        command_buffers::reset_query_pool( VkQueryPool query_pool_handle, uint32_t first_query, uint32_t query_count, uint32_t index )
+        {
+            vkCmdResetQueryPool( command_buffer_handles_[index], query_pool_handle, first_query, query_count );
+        }
+
+        void
+        command_buffers::write_timestamp( VkPipelineStageFlagBits pipeline_stage, VkQueryPool query_pool_handle, uint32_t query, uint32_t index )
+        {
+            vkCmdWriteTimestamp( command_buffer_handles_[index], pipeline_stage, query_pool_handle, query );
+        }
+
+        void
+        command_buffers::push_constants( VkPipelineLayout& pipeline_layout, VkShaderStageFlags stage_flags,
+                                         uint32_t offset, uint32_t size, const void* p_values, uint32_t index )
+        {
+            vkCmdPushConstants( command_buffer_handles_[index], pipeline_layout, stage_flags, offset, size, p_values );
+        }
+
+        void
+        command_buffers::dispatch( uint32_t group_count_x, uint32_t group_count_y, uint32_t group_count_z, uint32_t index )
+        {
+            vkCmdDispatch( command_buffer_handles_[index], group_count_x, group_count_y, group_count_z );
+        }
+        void
+        command_buffers::dispatch_indirect( VkBuffer& buffer, VkDeviceSize offset, uint32_t index )
+        {
+            vkCmdDispatchIndirect( command_buffer_handles_[index], buffer, offset );
+        }
+
+        void
+        command_buffers::buffer_barrier( VkBuffer& buffer, VkAccessFlags src_access_mask, VkAccessFlags dst_access_mask,
+                                         VkPipelineStageFlags src_stage_mask, VkPipelineStageFlags dst_stage_mask, uint32_t index )
+        {
+            VkBufferMemoryBarrier barrier = {};
+            barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+            barrier.srcAccessMask = src_access_mask;
+            barrier.dstAccessMask = dst_access_mask;
+            barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.buffer = buffer;
+            barrier.offset = 0;
+            barrier.size = VK_WHOLE_SIZE;
+
+            pipeline_barrier( src_stage_mask, dst_stage_mask, 0, nullptr, 1, &barrier, 0, nullptr, index );
+        }
 
         void
         command_buffers::set_viewport( uint32_t first_viewport, uint32_t viewport_count, VkViewport* p_viewports, uint32_t index )
@@ -135,6 +216,32 @@ namespace vk
         {
             vkCmdCopyBuffer( command_buffer_handles_[index], src_buffer, dst_buffer, region_count, p_regions );
         }
+        void
+        command_buffers::copy_image_to_buffer( VkImage& src_image, VkImageLayout src_image_layout, VkBuffer& dst_buffer,
+                                               uint32_t region_count, const VkBufferImageCopy* p_regions, uint32_t index )
+        {
+            vkCmdCopyImageToBuffer( command_buffer_handles_[index], src_image, src_image_layout, dst_buffer, region_count, p_regions );
+        }
+
+        void
+        command_buffers::copy_buffer_to_image( VkBuffer& src_buffer, VkImage& dst_image, VkImageLayout dst_image_layout,
+                                               uint32_t region_count, const VkBufferImageCopy* p_regions, uint32_t index )
+        {
+            vkCmdCopyBufferToImage( command_buffer_handles_[index], src_buffer, dst_image, dst_image_layout, region_count, p_regions );
+        }
+
+        void
+        command_buffers::pipeline_barrier( VkPipelineStageFlags src_stage_mask, VkPipelineStageFlags dst_stage_mask,
+                                           uint32_t memory_barrier_count, const VkMemoryBarrier* p_memory_barriers,
+                                           uint32_t buffer_memory_barrier_count, const VkBufferMemoryBarrier* p_buffer_memory_barriers,
+                                           uint32_t image_memory_barrier_count, const VkImageMemoryBarrier* p_image_memory_barriers,
+                                           uint32_t index )
+        {
+            vkCmdPipelineBarrier( command_buffer_handles_[index], src_stage_mask, dst_stage_mask, 0,
+                                  memory_barrier_count, p_memory_barriers,
+                                  buffer_memory_barrier_count, p_buffer_memory_barriers,
+                                  image_memory_barrier_count, p_image_memory_barriers );
+        }
 
         void
         command_buffers::set_scissor( uint32_t first_scissor, uint32_t scissor_count, VkRect2D* p_scissors,
@@ -17,18 +17,32 @@ namespace vk
         {
         public:
             command_buffers( ) = default;
-            command_buffers( const command_pool* p_command_pool, size_t count );
+            command_buffers( const command_pool* p_command_pool, size_t count,
+                             VkCommandBufferLevel level = VK_COMMAND_BUFFER_LEVEL_PRIMARY );
             command_buffers( const command_buffers& command_buffers ) = delete;
             command_buffers( command_buffers&& command_buffers ) noexcept;
             ~command_buffers( );
 
             void begin( VkCommandBufferUsageFlags flags, uint32_t index );
+            void begin( VkCommandBufferUsageFlags flags, const VkCommandBufferInheritanceInfo& inheritance_info, uint32_t index );
             void end( uint32_t index );
 
             void begin_render_pass( VkRenderPassBeginInfo& begin_info, VkSubpassContents contents, uint32_t index );
             void end_render_pass( uint32_t index );
 
+            void execute_commands( uint32_t command_buffer_count, const VkCommandBuffer* p_command_buffers, uint32_t index );
+
             void copy_buffer( VkBuffer& src_buffer, VkBuffer& dst_buffer, uint32_t region_count, const VkBufferCopy* p_regions, uint32_t index );
+            void copy_image_to_buffer( VkImage& src_image, VkImageLayout src_image_layout, VkBuffer& dst_buffer,
+                                       uint32_t region_count, const VkBufferImageCopy* p_regions, uint32_t index );
+            void copy_buffer_to_image( VkBuffer& src_buffer, VkImage& dst_image, VkImageLayout dst_image_layout,
+                                       uint32_t region_count, const VkBufferImageCopy* p_regions, uint32_t index );
+
+            void pipeline_barrier( VkPipelineStageFlags src_stage_mask, VkPipelineStageFlags dst_stage_mask,
+                                   uint32_t memory_barrier_count, const VkMemoryBarrier* p_memory_barriers,
+                                   uint32_t buffer_memory_barrier_count, const VkBufferMemoryBarrier* p_buffer_memory_barriers,
+                                   uint32_t image_memory_barrier_count, const VkImageMemoryBarrier* p_image_memory_barriers,
+                                   uint32_t index );
 
             void set_viewport( uint32_t first_viewport, uint32_t viewport_count, VkViewport* p_viewports, uint32_t index );
             void set_scissor( uint32_t first_scissor, uint32_t scissor_count, VkRect2D* p_scissors, uint32_t index );
@@ -41,8 +55,26 @@ namespace vk
             void bind_vertex_buffers( uint32_t first_binding, uint32_t binding_count, VkBuffer* p_buffers, VkDeviceSize* p_offset, uint32_t index );
             void bind_index_buffer( VkBuffer& buffer, VkDeviceSize offset, VkIndexType index_type, uint32_t index );
 
+            void push_constants( VkPipelineLayout& pipeline_layout, VkShaderStageFlags stage_flags,
+                                 uint32_t offset, uint32_t size, const void* p_values, uint32_t index );
+
+            void dispatch( uint32_t group_count_x, uint32_t group_count_y, uint32_t group_count_z, uint32_t index );
+            void dispatch_indirect( VkBuffer& buffer, VkDeviceSize offset, uint32_t index );
+
+            void buffer_barrier( VkBuffer& buffer, VkAccessFlags src_access_mask, VkAccessFlags dst_access_mask,
+                                 VkPipelineStageFlags src_stage_mask, VkPipelineStageFlags dst_stage_mask, uint32_t index );
+
             void draw_indexed( uint32_t index_count, uint32_t instance_count, uint32_t first_index,
                                int32_t vertex_offset, uint32_t first_instance, uint32_t index );
+            void draw_indexed_indirect( VkBuffer& buffer, VkDeviceSize offset, uint32_t draw_count, uint32_t stride, uint32_t index );
+            void draw_indexed_indirect_count( PFN_vkCmdDrawIndexedIndirectCountKHR p_function, VkBuffer& buffer, VkDeviceSize offset,
+                                              VkBuffer& count_buffer, VkDeviceSize count_buffer_offset,
+                                              uint32_t max_draw_count, uint32_t stride, uint32_t index );
+
+            void fill_buffer( VkBuffer& buffer, VkDeviceSize offset, VkDeviceSize size, uint32_t data, uint32_t index );
+
+            void reset_query_pool( VkQueryPool query_pool_handle, uint32_t first_query, uint32_t query_count, uint32_t index );
+            void write_timestamp( VkPipelineStageFlagBits pipeline_stage, VkQueryPool query_pool_handle, uint32_t query, uint32_t index );
 
             command_buffers& operator=( const command_buffers& command_buffers ) = delete;
             command_buffers& operator=( command_buffers&& command_buffers ) noexcept;
@@ -55,10 +87,10 @@ namespace vk
             }
 
         private:
-            const command_pool* p_command_pool_;
+            const command_pool* p_command_pool_ = nullptr;
 
             VkCommandBuffer* command_buffer_handles_ = VK_NULL_HANDLE;
-            size_t count_;
+            size_t count_ = 0;
         };
 
     }
@@ -10,12 +10,14 @@ namespace vk
     {
         command_pool::command_pool( const physical_device& physical_device,
                                   const logical_device* p_logical_device,
-                                  const helpers::queue_family_type& type )
+                                  const helpers::queue_family_type& type,
+                                  VkCommandPoolCreateFlags flags )
                 :
                 p_logical_device_( p_logical_device )
         {
             VkCommandPoolCreateInfo create_info = {};
             create_info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+            create_info.flags = flags;
             create_info.queueFamilyIndex = static_cast<uint32_t>( physical_device.get_queue_family_index( type ) );
 
             command_pool_handle_ = p_logical_device_->create_command_pool( create_info );
@@ -45,6 +47,12 @@ namespace vk
             return p_logical_device_->free_command_buffers( command_pool_handle_, command_buffer_handles, count );
         }
 
+        void
+        command_pool::reset( VkCommandPoolResetFlags flags )
+        {
+            p_logical_device_->reset_command_pool( command_pool_handle_, flags );
+        }
+
         command_pool&
         command_pool::operator=( command_pool&& command_pool ) noexcept
         {
@@ -19,7 +19,8 @@ namespace vk
             command_pool( ) = default;
             command_pool( const physical_device& physical_device,
                          const logical_device* p_logical_device,
-                         const helpers::queue_family_type& type );
+                         const helpers::queue_family_type& type,
+                         VkCommandPoolCreateFlags flags = 0 );
             command_pool( const command_pool& command_pool ) = delete;
             command_pool( command_pool&& command_pool ) noexcept;
             ~command_pool( );
@@ -32,6 +33,8 @@ namespace vk
             VkCommandBuffer* allocate_command_buffers( VkCommandBufferAllocateInfo& allocate_info, uint32_t count ) const;
             VkCommandBuffer* free_command_buffers( VkCommandBuffer* command_buffer_handles, uint32_t count ) const;
 
+            void reset( VkCommandPoolResetFlags flags = 0 );
+
             command_pool& operator=( const command_pool& command_pool ) = delete;
             command_pool& operator=( command_pool&& command_pool ) noexcept;
 
@@ -8,5 +8,67 @@ namespace vk
 {
     namespace core
     {
+        compute_pipeline::compute_pipeline( const logical_device* p_logical_device, const pipeline_cache& pipeline_cache,
+                                            const descriptor_set_layout& descriptor_set_layout,
+                                            shader_module& compute_shader, uint32_t push_constant_size )
+            :
+            p_logical_device_( p_logical_device )
+        {
+            VkPushConstantRange push_constant_range = {};
+            push_constant_range.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+            push_constant_range.offset = 0;
+            push_constant_range.size = push_constant_size;
+
+            VkPipelineLayoutCreateInfo pipeline_layout_info = {};
+            pipeline_layout_info.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+            pipeline_layout_info.setLayoutCount = 1;
+            pipeline_layout_info.pSetLayouts = &descriptor_set_layout.get();
+            pipeline_layout_info.pushConstantRangeCount = push_constant_size > 0 ? 1 : 0;
+            pipeline_layout_info.pPushConstantRanges = push_constant_size > 0 ? &push_constant_range : nullptr;
+
+            pipeline_layout_handle_ = p_logical_device_->create_pipeline_layout( pipeline_layout_info );
+
+            VkComputePipelineCreateInfo create_info = {};
+            create_info.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+            create_info.stage = compute_shader.create_shader_stage_info( VK_SHADER_STAGE_COMPUTE_BIT );
+            create_info.layout = pipeline_layout_handle_;
+
+            pipeline_handle_ = p_logical_device_->create_compute_pipeline( pipeline_cache.get(), create_info );
+        }
+        compute_pipeline::compute_pipeline( compute_pipeline&& compute_pipeline ) noexcept
+        {
+            *this = std::move( compute_pipeline );
+        }
+        compute_pipeline::~compute_pipeline( )
+        {
+            if( pipeline_handle_ != VK_NULL_HANDLE )
+                pipeline_handle_ = p_logical_device_->destroy_pipeline( pipeline_handle_ );
+
+            if( pipeline_layout_handle_ != VK_NULL_HANDLE )
+                pipeline_layout_handle_ = p_logical_device_->destroy_pipeline_layout( pipeline_layout_handle_ );
+        }
+
+        compute_pipeline&
+        compute_pipeline::operator=( compute_pipeline&& compute_pipeline ) noexcept
+        {
+            if( this != &compute_pipeline )
+            {
+                if( pipeline_handle_ != VK_NULL_HANDLE )
+                    pipeline_handle_ = p_logical_device_->destroy_pipeline( pipeline_handle_ );
+
+                if( pipeline_layout_handle_ != VK_NULL_HANDLE )
+                    pipeline_layout_handle_ = p_logical_device_->destroy_pipeline_layout( pipeline_layout_handle_ );
+
+                pipeline_handle_ = compute_pipeline.pipeline_handle_;
+                compute_pipeline.pipeline_handle_ = VK_NULL_HANDLE;
+
+                pipeline_layout_handle_ = compute_pipeline.pipeline_layout_handle_;
+                compute_pipeline.pipeline_layout_handle_ = VK_NULL_HANDLE;
+
+                p_logical_device_ = compute_pipeline.p_logical_device_;
+            }
+
+            return *this;
+        }
     }
-}
\ No newline at end of file
+}
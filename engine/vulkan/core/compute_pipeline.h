@@ -7,6 +7,8 @@
 
 #include "logical_device.h"
 #include "shader_module.h"
+#include "descriptor_set_layout.h"
+#include "pipeline_cache.h"
 
 namespace vk
 {
@@ -16,10 +18,28 @@ namespace vk
         {
         public:
             compute_pipeline( ) = default;
-            compute_pipeline( const logical_device* p_logical_device, shader_module& computer_shader );
+            compute_pipeline( const logical_device* p_logical_device, const pipeline_cache& pipeline_cache,
+                              const descriptor_set_layout& descriptor_set_layout,
+                              shader_module& compute_shader, uint32_t push_constant_size = 0 );
+            compute_pipeline( const compute_pipeline& compute_pipeline ) = delete;
+            compute_pipeline( compute_pipeline&& compute_pipeline ) noexcept;
+            ~compute_pipeline( );
+
+            VkPipeline& get()
+            {
+                return pipeline_handle_;
+            }
+
+            VkPipelineLayout& get_layout()
+            {
+                return pipeline_layout_handle_;
+            }
+
+            compute_pipeline& operator=( const compute_pipeline& compute_pipeline ) = delete;
+            compute_pipeline& operator=( compute_pipeline&& compute_pipeline ) noexcept;
 
         private:
-            const logical_device* p_logical_device_;
+            const logical_device* p_logical_device_ = nullptr;
 
             VkPipeline pipeline_handle_ = VK_NULL_HANDLE;
             VkPipelineLayout pipeline_layout_handle_ = VK_NULL_HANDLE;
@@ -0,0 +1,61 @@
+/*!
+ *
+ */
+
+#include "deletion_queue.h"
+
+namespace vk
+{
+    namespace core
+    {
+        deletion_queue::deletion_queue( uint32_t frame_latency )
+            :
+            frame_latency_( frame_latency )
+        {
+        }
+        deletion_queue::deletion_queue( deletion_queue&& deletion_queue ) noexcept
+        {
+            *this = std::move( deletion_queue );
+        }
+        deletion_queue::~deletion_queue( )
+        {
+            flush( );
+        }
+
+        void
+        deletion_queue::begin_frame( uint64_t frame_number )
+        {
+            frame_number_ = frame_number;
+
+            while( !retired_.empty() && retired_.front().frame_number + frame_latency_ <= frame_number_ )
+                retired_.pop_front();
+        }
+
+        void
+        deletion_queue::flush( )
+        {
+            /*
+             * Oldest first, the same order they would have been destroyed in over time.
+             */
+            while( !retired_.empty() )
+                retired_.pop_front();
+        }
+
+        deletion_queue&
+        deletion_queue::operator=( deletion_queue&& deletion_queue ) noexcept
+        {
+            if( this != &deletion_queue )
+            {
+                flush( );
+
+                retired_ = std::move( deletion_queue.retired_ );
+                deletion_queue.retired_.clear();
+
+                frame_number_ = deletion_queue.frame_number_;
+                frame_latency_ = deletion_queue.frame_latency_;
+            }
+
+            return *this;
+        }
+    }
+}
@@ -0,0 +1,85 @@
+/*!
+ * @brief Keeps retired resources alive until the GPU is done with them.
+ * A resource handed to retire() is tagged with the current frame and
+ * destroyed, through its own destructor, once the fence of that frame
+ * has been waited on.
+ */
+
+#ifndef PROJEKT_DELETION_QUEUE_H
+#define PROJEKT_DELETION_QUEUE_H
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <type_traits>
+
+namespace vk
+{
+    namespace core
+    {
+        class deletion_queue
+        {
+        public:
+            deletion_queue( ) = default;
+            explicit deletion_queue( uint32_t frame_latency );
+            deletion_queue( const deletion_queue& deletion_queue ) = delete;
+            deletion_queue( deletion_queue&& deletion_queue ) noexcept;
+            ~deletion_queue( );
+
+            template<typename T>
+            void retire( T&& resource )
+            {
+                static_assert( !std::is_lvalue_reference<T>::value, "Resources must be moved into the deletion queue." );
+
+                retired_.push_back( { frame_number_, std::make_unique<entry<T>>( std::move( resource ) ) } );
+            }
+
+            /*
+             * Must be called once the fence of the frame frame_latency back from frame_number
+             * has been waited on. Destroys everything that frame was the last possible user of.
+             */
+            void begin_frame( uint64_t frame_number );
+
+            /*
+             * Destroys everything straight away, only safe once the device is idle.
+             */
+            void flush( );
+
+            size_t get_count( ) const
+            {
+                return retired_.size();
+            }
+
+            deletion_queue& operator=( const deletion_queue& deletion_queue ) = delete;
+            deletion_queue& operator=( deletion_queue&& deletion_queue ) noexcept;
+
+        private:
+            struct entry_base
+            {
+                virtual ~entry_base( ) = default;
+            };
+
+            template<typename T>
+            struct entry : entry_base
+            {
+                explicit entry( T&& resource ) : resource( std::move( resource ) ) { }
+
+                T resource;
+            };
+
+            struct retired_resource
+            {
+                uint64_t frame_number;
+                std::unique_ptr<entry_base> p_entry;
+            };
+
+        private:
+            std::deque<retired_resource> retired_;
+
+            uint64_t frame_number_ = 0;
+            uint32_t frame_latency_ = 0;
+        };
+    }
+}
+
+#endif //PROJEKT_DELETION_QUEUE_H
@@ -8,12 +8,12 @@ namespace vk
 {
     namespace core
     {
-        descriptor_pool::descriptor_pool( const logical_device* p_logical_device, uint32_t count )
+        descriptor_pool::descriptor_pool( const logical_device* p_logical_device, VkDescriptorType type, uint32_t count )
             :
             p_logical_device_( p_logical_device )
         {
             VkDescriptorPoolSize pool_size = {};
-            pool_size.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+            pool_size.type = type;
             pool_size.descriptorCount = count;
 
             VkDescriptorPoolCreateInfo create_info = {};
@@ -24,6 +24,19 @@ namespace vk
 
             descriptor_pool_handle_ = p_logical_device_->create_descriptor_pool( create_info );
         }
+        descriptor_pool::descriptor_pool( const logical_device* p_logical_device, const std::vector<VkDescriptorPoolSize>& pool_sizes,
+                                          uint32_t max_sets )
+            :
+            p_logical_device_( p_logical_device )
+        {
+            VkDescriptorPoolCreateInfo create_info = {};
+            create_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+            create_info.poolSizeCount = static_cast<uint32_t>( pool_sizes.size() );
+            create_info.pPoolSizes = pool_sizes.data();
+            create_info.maxSets = max_sets;
+
+            descriptor_pool_handle_ = p_logical_device_->create_descriptor_pool( create_info );
+        }
         descriptor_pool::descriptor_pool( descriptor_pool&& descriptor_pool ) noexcept
         {
             *this = std::move( descriptor_pool );
@@ -5,6 +5,8 @@
 #ifndef PROJEKT_DESCRIPTOR_POOL_H
 #define PROJEKT_DESCRIPTOR_POOL_H
 
+#include <vector>
+
 #include "logical_device.h"
 
 namespace vk
@@ -15,7 +17,8 @@ namespace vk
         {
         public:
             descriptor_pool( ) = default;
-            descriptor_pool( const logical_device* p_logical_device, uint32_t count );
+            descriptor_pool( const logical_device* p_logical_device, VkDescriptorType type, uint32_t count );
+            descriptor_pool( const logical_device* p_logical_device, const std::vector<VkDescriptorPoolSize>& pool_sizes, uint32_t max_sets );
             descriptor_pool( const descriptor_pool& descriptor_pool ) = delete;
             descriptor_pool( descriptor_pool&& descriptor_pool ) noexcept;
             ~descriptor_pool( );
@@ -8,13 +8,13 @@ namespace vk
 {
     namespace core
     {
-        descriptor_set_layout::descriptor_set_layout( const logical_device* p_logical_device, VkShaderStageFlags flags )
+        descriptor_set_layout::descriptor_set_layout( const logical_device* p_logical_device, VkDescriptorType type, VkShaderStageFlags flags )
             :
             p_logical_device_( p_logical_device )
         {
             VkDescriptorSetLayoutBinding ubo_layout_binding = {};
             ubo_layout_binding.binding = 0;
-            ubo_layout_binding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+            ubo_layout_binding.descriptorType = type;
             ubo_layout_binding.descriptorCount = 1;
             ubo_layout_binding.stageFlags = flags;
 
@@ -25,6 +25,18 @@ namespace vk
 
             descriptor_set_layout_handle_ = p_logical_device_->create_descriptor_set_layout( create_info );
         }
+        descriptor_set_layout::descriptor_set_layout( const logical_device* p_logical_device,
+                                                      const std::vector<VkDescriptorSetLayoutBinding>& bindings )
+            :
+            p_logical_device_( p_logical_device )
+        {
+            VkDescriptorSetLayoutCreateInfo create_info = {};
+            create_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+            create_info.bindingCount = static_cast<uint32_t>( bindings.size() );
+            create_info.pBindings = bindings.data();
+
+            descriptor_set_layout_handle_ = p_logical_device_->create_descriptor_set_layout( create_info );
+        }
         descriptor_set_layout::descriptor_set_layout( descriptor_set_layout&& descriptor_set_layout ) noexcept
         {
             *this = std::move( descriptor_set_layout );
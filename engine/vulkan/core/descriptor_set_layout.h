@@ -7,6 +7,8 @@
 
 #include <vulkan/vulkan.h>
 
+#include <vector>
+
 #include "logical_device.h"
 
 namespace vk
@@ -17,7 +19,8 @@ namespace vk
         {
         public:
             descriptor_set_layout() = default;
-            descriptor_set_layout( const logical_device* p_logical_device, VkShaderStageFlags flags );
+            descriptor_set_layout( const logical_device* p_logical_device, VkDescriptorType type, VkShaderStageFlags flags );
+            descriptor_set_layout( const logical_device* p_logical_device, const std::vector<VkDescriptorSetLayoutBinding>& bindings );
             descriptor_set_layout( const descriptor_set_layout& descriptor_set_layout ) = delete;
             descriptor_set_layout( descriptor_set_layout&& descriptor_set_layout ) noexcept;
             ~descriptor_set_layout( );
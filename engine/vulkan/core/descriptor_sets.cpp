@@ -12,6 +12,7 @@ namespace vk
         descriptor_sets::descriptor_sets( const logical_device& logical_device,
                                           const descriptor_pool* p_descriptor_pool,
                                           const descriptor_set_layout& set_layout,
+                                          VkDescriptorType type,
                                           const VkBuffer* p_buffers,
                                           const VkDeviceSize buffer_range, uint32_t count )
             :
@@ -40,12 +41,30 @@ namespace vk
                 descriptor_write.dstBinding = 0;
                 descriptor_write.dstArrayElement = 0;
                 descriptor_write.descriptorCount = 1;
-                descriptor_write.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+                descriptor_write.descriptorType = type;
                 descriptor_write.pBufferInfo = &buffer_info;
 
                 logical_device.update_descriptor_set( 1, &descriptor_write, 0, nullptr );
             }
         }
+        descriptor_sets::descriptor_sets( const logical_device& logical_device,
+                                          const descriptor_pool* p_descriptor_pool,
+                                          const descriptor_set_layout& set_layout,
+                                          VkDescriptorType type,
+                                          const std::vector<VkDescriptorBufferInfo>& buffer_infos )
+            :
+            p_descriptor_pool_( p_descriptor_pool ),
+            count_( 1 )
+        {
+            VkDescriptorSetAllocateInfo allocate_info = {};
+            allocate_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+            allocate_info.descriptorSetCount = count_;
+            allocate_info.pSetLayouts = &set_layout.get();
+
+            descriptor_set_handles_ = p_descriptor_pool_->allocate_descriptor_set( allocate_info, count_ );
+
+            update( logical_device, type, buffer_infos, 0 );
+        }
         descriptor_sets::descriptor_sets( descriptor_sets&& descriptor_sets ) noexcept
         {
             *this = std::move( descriptor_sets );
@@ -58,6 +77,27 @@ namespace vk
             */
         }
 
+        void
+        descriptor_sets::update( const logical_device& logical_device, VkDescriptorType type,
+                                 const std::vector<VkDescriptorBufferInfo>& buffer_infos, uint32_t index, uint32_t first_binding )
+        {
+            std::vector<VkWriteDescriptorSet> descriptor_writes( buffer_infos.size() );
+
+            for( uint32_t i = 0; i < buffer_infos.size(); ++i )
+            {
+                auto& descriptor_write = descriptor_writes[i];
+                descriptor_write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+                descriptor_write.dstSet = descriptor_set_handles_[index];
+                descriptor_write.dstBinding = first_binding + i;
+                descriptor_write.dstArrayElement = 0;
+                descriptor_write.descriptorCount = 1;
+                descriptor_write.descriptorType = type;
+                descriptor_write.pBufferInfo = &buffer_infos[i];
+            }
+
+            logical_device.update_descriptor_set( static_cast<uint32_t>( descriptor_writes.size() ), descriptor_writes.data(), 0, nullptr );
+        }
+
         descriptor_sets& descriptor_sets::operator=( descriptor_sets&& descriptor_sets ) noexcept
         {
             if( this != &descriptor_sets )
@@ -5,6 +5,8 @@
 #ifndef PROJEKT_DESCRIPTOR_SET_H
 #define PROJEKT_DESCRIPTOR_SET_H
 
+#include <vector>
+
 #include "logical_device.h"
 #include "descriptor_set_layout.h"
 #include "descriptor_pool.h"
@@ -19,7 +21,10 @@ namespace vk
             descriptor_sets( ) = default;
             descriptor_sets( const logical_device& logical_device,
                              const descriptor_pool* p_descriptor_pool, const descriptor_set_layout& set_layout,
-                             const VkBuffer* p_buffers, const VkDeviceSize buffer_range, uint32_t count );
+                             VkDescriptorType type, const VkBuffer* p_buffers, const VkDeviceSize buffer_range, uint32_t count );
+            descriptor_sets( const logical_device& logical_device,
+                             const descriptor_pool* p_descriptor_pool, const descriptor_set_layout& set_layout,
+                             VkDescriptorType type, const std::vector<VkDescriptorBufferInfo>& buffer_infos );
             descriptor_sets( const descriptor_sets& descriptor_sets ) = delete;
             descriptor_sets( descriptor_sets&& descriptor_sets ) noexcept;
             ~descriptor_sets( );
@@ -29,6 +34,9 @@ namespace vk
                 return descriptor_set_handles_[index];
             }
 
+            void update( const logical_device& logical_device, VkDescriptorType type,
+                         const std::vector<VkDescriptorBufferInfo>& buffer_infos, uint32_t index, uint32_t first_binding = 0 );
+
             descriptor_sets& operator=( const descriptor_sets& descriptor_sets ) = delete;
             descriptor_sets& operator=( descriptor_sets&& descriptor_sets ) noexcept;
 
@@ -41,11 +41,20 @@ namespace vk
             p_logical_device_->reset_fences( &fence_handles_[fence_index], 1 );
         }
 
+        bool
+        fences::is_signaled( size_t fence_index ) const
+        {
+            return p_logical_device_->get_fence_status( fence_handles_[fence_index] ) == VK_SUCCESS;
+        }
+
         fences&
         fences::operator=( fences&& fences ) noexcept
         {
             if ( this != &fences )
             {
+                if( fence_handles_ != VK_NULL_HANDLE )
+                    fence_handles_ = p_logical_device_->destroy_fences( fence_handles_, count_ );
+
                 count_ = fences.count_;
                 fences.count_ = 0;
 
@@ -26,6 +26,7 @@ namespace vk
 
             void wait_for_fence( size_t fence_index, VkBool32 wait_all, uint64_t timeout );
             void reset_fence( size_t fence_index );
+            bool is_signaled( size_t fence_index ) const;
 
             fences& operator=( const fences& fences ) = delete;
             fences& operator=( fences&& fences ) noexcept;
@@ -35,8 +36,8 @@ namespace vk
         private:
             const logical_device* p_logical_device_ = nullptr;
 
-            VkFence* fence_handles_;
-            uint32_t count_;
+            VkFence* fence_handles_ = VK_NULL_HANDLE;
+            uint32_t count_ = 0;
         };
     }
 }
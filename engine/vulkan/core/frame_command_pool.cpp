@@ -0,0 +1,83 @@
+/*!
+ *
+ */
+
+#include "frame_command_pool.h"
+
+namespace vk
+{
+    namespace core
+    {
+        frame_command_pool::frame_command_pool( const physical_device& physical_device, const logical_device* p_logical_device,
+                                                const helpers::queue_family_type& type )
+            :
+            p_command_pool_( std::make_unique<command_pool>( physical_device, p_logical_device, type,
+                                                             VK_COMMAND_POOL_CREATE_TRANSIENT_BIT ) )
+        {
+        }
+        frame_command_pool::frame_command_pool( frame_command_pool&& frame_command_pool ) noexcept
+        {
+            *this = std::move( frame_command_pool );
+        }
+        frame_command_pool::~frame_command_pool( )
+        {
+            destroy( );
+        }
+
+        void
+        frame_command_pool::reset( )
+        {
+            p_command_pool_->reset( );
+
+            primary_.used = 0;
+            secondary_.used = 0;
+        }
+
+        command_buffers&
+        frame_command_pool::acquire( VkCommandBufferLevel level )
+        {
+            auto& list = get_list( level );
+
+            if( list.used == list.buffers.size() )
+                list.buffers.emplace_back( p_command_pool_.get(), 1, level );
+
+            return list.buffers[list.used++];
+        }
+
+        frame_command_pool&
+        frame_command_pool::operator=( frame_command_pool&& frame_command_pool ) noexcept
+        {
+            if( this != &frame_command_pool )
+            {
+                destroy( );
+
+                p_command_pool_ = std::move( frame_command_pool.p_command_pool_ );
+
+                primary_.buffers = std::move( frame_command_pool.primary_.buffers );
+                primary_.used = frame_command_pool.primary_.used;
+
+                secondary_.buffers = std::move( frame_command_pool.secondary_.buffers );
+                secondary_.used = frame_command_pool.secondary_.used;
+
+                frame_command_pool.primary_ = {};
+                frame_command_pool.secondary_ = {};
+            }
+
+            return *this;
+        }
+
+        frame_command_pool::recycled_list&
+        frame_command_pool::get_list( VkCommandBufferLevel level )
+        {
+            return level == VK_COMMAND_BUFFER_LEVEL_PRIMARY ? primary_ : secondary_;
+        }
+        void
+        frame_command_pool::destroy( )
+        {
+            primary_.buffers.clear();
+            secondary_.buffers.clear();
+
+            p_command_pool_.reset();
+        }
+    }
+}
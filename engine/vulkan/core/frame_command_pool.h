@@ -0,0 +1,63 @@
+/*!
+ * @brief Transient command pool for a single frame in flight. The pool is
+ * reset as a whole once the frame's fence has signaled and the command
+ * buffers it handed out are recycled instead of freed.
+ */
+
+#ifndef PROJEKT_FRAME_COMMAND_POOL_H
+#define PROJEKT_FRAME_COMMAND_POOL_H
+
+#include <deque>
+#include <memory>
+
+#include <vulkan/vulkan.h>
+
+#include "logical_device.h"
+#include "command_pool.h"
+#include "command_buffers.h"
+
+namespace vk
+{
+    namespace core
+    {
+        class frame_command_pool
+        {
+        public:
+            frame_command_pool( ) = default;
+            frame_command_pool( const physical_device& physical_device, const logical_device* p_logical_device,
+                                const helpers::queue_family_type& type );
+            frame_command_pool( const frame_command_pool& frame_command_pool ) = delete;
+            frame_command_pool( frame_command_pool&& frame_command_pool ) noexcept;
+            ~frame_command_pool( );
+
+            void reset( );
+
+            command_buffers& acquire( VkCommandBufferLevel level );
+
+            frame_command_pool& operator=( const frame_command_pool& frame_command_pool ) = delete;
+            frame_command_pool& operator=( frame_command_pool&& frame_command_pool ) noexcept;
+
+        private:
+            struct recycled_list
+            {
+                std::deque<command_buffers> buffers;
+                size_t used = 0;
+            };
+
+            recycled_list& get_list( VkCommandBufferLevel level );
+            void destroy( );
+
+        private:
+            /*
+             * command_buffers keep a pointer to their pool, so the pool lives on the heap
+             * to stay put when this object is moved.
+             */
+            std::unique_ptr<command_pool> p_command_pool_;
+
+            recycled_list primary_;
+            recycled_list secondary_;
+        };
+    }
+}
+
+#endif //PROJEKT_FRAME_COMMAND_POOL_H
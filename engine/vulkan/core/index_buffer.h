@@ -6,8 +6,9 @@
 #define PROJEKT_INDEX_BUFFER_H
 
 #include "logical_device.h"
-#include "command_pool.h"
-#include "queue.h"
+#include "buffer.h"
+#include "memory_allocator.h"
+#include "upload_manager.h"
 #include "../graphics/vertex.h"
 
 namespace vk
@@ -18,16 +19,15 @@ namespace vk
         {
         public:
             index_buffer( ) = default;
-            index_buffer( const logical_device* p_logical_device, const physical_device& physical_device,
-                          const command_pool& command_pool, queue& queue,
-                          const std::vector<std::uint16_t>& indices );
+            index_buffer( const logical_device* p_logical_device, memory_allocator* p_memory_allocator,
+                          upload_manager& upload_manager, const std::vector<std::uint16_t>& indices );
             index_buffer( const index_buffer& index_buffer ) = delete;
             index_buffer( index_buffer&& index_buffer ) noexcept;
-            ~index_buffer( );
+            ~index_buffer( ) = default;
 
             VkBuffer& get()
             {
-                return buffer_handle_;
+                return buffer_.get();
             }
 
             uint32_t get_count()
@@ -35,23 +35,20 @@ namespace vk
                 return count_;
             }
 
+            upload_ticket get_upload_ticket() const
+            {
+                return upload_ticket_;
+            }
+
             index_buffer& operator=( const index_buffer& index_buffer ) = delete;
             index_buffer& operator=( index_buffer&& index_buffer ) noexcept;
 
         private:
-            void create_buffer( const physical_device& physical_device, VkDeviceSize& size, VkBufferUsageFlags usage,
-                                VkMemoryPropertyFlags properties, VkBuffer& buffer, VkDeviceMemory& buffer_memory );
-            void copy_buffer( const command_pool& command_pool, queue& queue, VkBuffer &src_buffer, VkBuffer &dst_buffer, VkDeviceSize &size );
-
-            uint32_t find_memory_type( const physical_device& physical_device, uint32_t type_filter, VkMemoryPropertyFlags properties );
-
-        private:
-            const logical_device* p_logical_device_;
+            buffer buffer_;
 
-            VkBuffer buffer_handle_ = VK_NULL_HANDLE;
-            VkDeviceMemory buffer_memory_handle_ = VK_NULL_HANDLE;
+            uint32_t count_ = 0;
 
-            uint32_t count_;
+            upload_ticket upload_ticket_ = 0;
         };
     }
 }
@@ -0,0 +1,41 @@
+/*!
+ *
+ */
+
+#include "instance_buffer.h"
+
+namespace vk
+{
+    namespace core
+    {
+        instance_buffer::instance_buffer( const logical_device* p_logical_device, memory_allocator* p_memory_allocator,
+                                          upload_manager& upload_manager, const std::vector<vk::graphics::instance_data>& instances )
+        {
+            VkDeviceSize buffer_size = sizeof( instances[0] ) * instances.size();
+
+            buffer_ = buffer( p_logical_device, p_memory_allocator, buffer_size,
+                              VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+                              VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, upload_manager.get_queue_family_indices() );
+
+            upload_ticket_ = upload_manager.upload_buffer( buffer_.get(), instances.data(), buffer_size );
+        }
+        instance_buffer::instance_buffer( instance_buffer&& instance_buffer ) noexcept
+        {
+            *this = std::move( instance_buffer );
+        }
+
+        instance_buffer&
+        instance_buffer::operator=( instance_buffer&& instance_buffer ) noexcept
+        {
+            if( this != &instance_buffer )
+            {
+                buffer_ = std::move( instance_buffer.buffer_ );
+
+                upload_ticket_ = instance_buffer.upload_ticket_;
+                instance_buffer.upload_ticket_ = 0;
+            }
+
+            return *this;
+        }
+    }
+}
@@ -0,0 +1,51 @@
+/*!
+ *
+ */
+
+#ifndef PROJEKT_INSTANCE_BUFFER_H
+#define PROJEKT_INSTANCE_BUFFER_H
+
+#include <vulkan/vulkan.h>
+
+#include "logical_device.h"
+#include "buffer.h"
+#include "memory_allocator.h"
+#include "upload_manager.h"
+#include "../graphics/instance_data.h"
+
+namespace vk
+{
+    namespace core
+    {
+        class instance_buffer
+        {
+        public:
+            instance_buffer( ) = default;
+            instance_buffer( const logical_device* p_logical_device, memory_allocator* p_memory_allocator,
+                             upload_manager& upload_manager, const std::vector<vk::graphics::instance_data>& instances );
+            instance_buffer( const instance_buffer& instance_buffer ) = delete;
+            instance_buffer( instance_buffer&& instance_buffer ) noexcept;
+            ~instance_buffer( ) = default;
+
+            VkBuffer& get()
+            {
+                return buffer_.get();
+            }
+
+            upload_ticket get_upload_ticket() const
+            {
+                return upload_ticket_;
+            }
+
+            instance_buffer& operator=( const instance_buffer& instance_buffer ) = delete;
+            instance_buffer& operator=( instance_buffer&& instance_buffer ) noexcept;
+
+        private:
+            buffer buffer_;
+
+            upload_ticket upload_ticket_ = 0;
+        };
+    }
+}
+
+#endif //PROJEKT_INSTANCE_BUFFER_H
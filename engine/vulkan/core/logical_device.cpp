@@ -8,6 +8,7 @@
 
 #include "logical_device.h"
 #include "instance.h"
+#include "../helpers/timeline_semaphore_types.h"
 #include "../../utils/exception/vulkan_exception.h"
 
 namespace vk
@@ -16,7 +17,8 @@ namespace vk
     {
         logical_device::logical_device( physical_device& physical_device,
                                       const std::vector<const char*>& validation_layers,
-                                      const std::vector<const char*>& device_extensions )
+                                      const std::vector<const char*>& device_extensions,
+                                      bool enable_timeline_semaphore )
         {
             std::vector<VkDeviceQueueCreateInfo> queue_create_infos;
             auto unique_queue_families = physical_device.unique_queue_families();
@@ -34,6 +36,7 @@ namespace vk
             }
 
             auto& physical_device_features = physical_device.features();
+            enabled_features_ = physical_device_features;
 
             VkDeviceCreateInfo create_info = {};
             create_info.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
@@ -43,6 +46,16 @@ namespace vk
             create_info.enabledExtensionCount = static_cast<uint32_t>( device_extensions.size() );
             create_info.ppEnabledExtensionNames = device_extensions.data();
 
+            VkPhysicalDeviceTimelineSemaphoreFeaturesKHR timeline_semaphore_features = {};
+            timeline_semaphore_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES_KHR;
+            timeline_semaphore_features.timelineSemaphore = VK_TRUE;
+
+            if( enable_timeline_semaphore )
+            {
+                create_info.pNext = &timeline_semaphore_features;
+                is_timeline_semaphore_enabled_ = true;
+            }
+
             if ( enable_validation_layers )
             {
                 create_info.enabledLayerCount = static_cast<uint32_t>( validation_layers.size() );
@@ -84,11 +97,22 @@ namespace vk
 
                 device_handle_ = logical_device.device_handle_;
                 logical_device.device_handle_ = VK_NULL_HANDLE;
+
+                is_timeline_semaphore_enabled_ = logical_device.is_timeline_semaphore_enabled_;
+                logical_device.is_timeline_semaphore_enabled_ = false;
+
+                enabled_features_ = logical_device.enabled_features_;
             }
 
             return *this;
         }
 
+        PFN_vkVoidFunction
+        logical_device::get_proc_address( const char* name ) const
+        {
+            return vkGetDeviceProcAddr( device_handle_, name );
+        }
+
         VkQueue
         logical_device::get_queue( int32_t family_index, uint32_t queue_index ) const
         {
@@ -116,6 +140,12 @@ namespace vk
 
             return VK_NULL_HANDLE;
         }
+        void
+        logical_device::reset_command_pool( VkCommandPool& command_pool_handle, VkCommandPoolResetFlags flags ) const
+        {
+            if( vkResetCommandPool( device_handle_, command_pool_handle, flags ) != VK_SUCCESS )
+                throw vulkan_exception{ "Failed to reset Command Pool.", __FILE__, __LINE__ };
+        }
 
         VkCommandBuffer*
         logical_device::allocate_command_buffers( VkCommandBufferAllocateInfo& allocate_info, uint32_t count ) const
@@ -195,6 +225,11 @@ namespace vk
         {
             vkResetFences( device_handle_, fence_count, p_fence_handle );
         }
+        VkResult
+        logical_device::get_fence_status( VkFence fence_handle ) const
+        {
+            return vkGetFenceStatus( device_handle_, fence_handle );
+        }
 
         VkSwapchainKHR
         logical_device::create_swapchain( VkSwapchainCreateInfoKHR& create_info ) const
@@ -375,6 +410,23 @@ namespace vk
 
             return VK_NULL_HANDLE;
         }
+        std::vector<char>
+        logical_device::get_pipeline_cache_data( VkPipelineCache pipeline_cache_handle ) const
+        {
+            size_t size = 0;
+
+            if( vkGetPipelineCacheData( device_handle_, pipeline_cache_handle, &size, nullptr ) != VK_SUCCESS )
+                throw vulkan_exception{ "Failed to query Pipeline Cache size.", __FILE__, __LINE__ };
+
+            std::vector<char> data( size );
+
+            if( vkGetPipelineCacheData( device_handle_, pipeline_cache_handle, &size, data.data() ) != VK_SUCCESS )
+                throw vulkan_exception{ "Failed to get Pipeline Cache data.", __FILE__, __LINE__ };
+
+            data.resize( size );
+
+            return data;
+        }
 
         VkPipeline
         logical_device::create_compute_pipeline( VkPipelineCache pipeline_cache_handle, VkComputePipelineCreateInfo& create_info ) const
@@ -432,6 +484,34 @@ namespace vk
             return mem_reqs;
         }
 
+        VkImage
+        logical_device::create_image( VkImageCreateInfo& create_info ) const
+        {
+            VkImage image_handle;
+
+            if( vkCreateImage( device_handle_, &create_info, nullptr, &image_handle ) != VK_SUCCESS )
+                throw vulkan_exception{ "Failed to create Image.", __FILE__, __LINE__ };
+
+            return image_handle;
+        }
+        VkImage
+        logical_device::destroy_image( VkImage& image_handle ) const
+        {
+            vkDestroyImage( device_handle_, image_handle, nullptr );
+
+            return VK_NULL_HANDLE;
+        }
+
+        VkMemoryRequirements
+        logical_device::get_image_memory_requirements( VkImage& image_handle ) const
+        {
+            VkMemoryRequirements mem_reqs;
+
+            vkGetImageMemoryRequirements( device_handle_, image_handle, &mem_reqs );
+
+            return mem_reqs;
+        }
+
         VkDeviceMemory
         logical_device::allocate_memory( VkMemoryAllocateInfo& allocate_info ) const
         {
@@ -456,6 +536,12 @@ namespace vk
         {
             vkBindBufferMemory( device_handle_, buffer_handle, memory_handle, offset );
         }
+        void
+        logical_device::bind_image_memory( VkImage& image_handle, VkDeviceMemory& memory_handle,
+                                           VkDeviceSize& offset ) const
+        {
+            vkBindImageMemory( device_handle_, image_handle, memory_handle, offset );
+        }
 
         void
         logical_device::map_memory( VkDeviceMemory& memory_handle, VkDeviceSize offset, VkDeviceSize& size,
@@ -529,5 +615,34 @@ namespace vk
 
             return VK_NULL_HANDLE;
         }
+
+        VkQueryPool
+        logical_device::create_query_pool( VkQueryPoolCreateInfo& create_info ) const
+        {
+            VkQueryPool query_pool_handle;
+
+            if( vkCreateQueryPool( device_handle_, &create_info, nullptr, &query_pool_handle ) != VK_SUCCESS )
+                throw vulkan_exception{ "Failed to create Query Pool.", __FILE__, __LINE__ };
+
+            return query_pool_handle;
+        }
+        VkQueryPool
+        logical_device::destroy_query_pool( VkQueryPool& query_pool_handle ) const
+        {
+            vkDestroyQueryPool( device_handle_, query_pool_handle, nullptr );
+
+            return VK_NULL_HANDLE;
+        }
+        VkResult
+        logical_device::get_query_pool_results( VkQueryPool query_pool_handle, uint32_t first_query, uint32_t query_count,
+                                                size_t data_size, void* p_data, VkDeviceSize stride, VkQueryResultFlags flags ) const
+        {
+            auto result = vkGetQueryPoolResults( device_handle_, query_pool_handle, first_query, query_count, data_size, p_data, stride, flags );
+
+            if( result != VK_SUCCESS && result != VK_NOT_READY )
+                throw vulkan_exception{ "Failed to get Query Pool results.", __FILE__, __LINE__ };
+
+            return result;
+        }
     }
 }
\ No newline at end of file
@@ -5,6 +5,8 @@
 #ifndef COMPUTE_LOGICALDEVICE_H
 #define COMPUTE_LOGICALDEVICE_H
 
+#include <vector>
+
 #include <vulkan/vulkan.h>
 
 #include "physical_device.h"
@@ -19,18 +21,31 @@ namespace vk
             logical_device( ) = default;
             logical_device( physical_device& physical_device,
                             const std::vector<const char*>& validation_layers,
-                            const std::vector<const char*>& device_extensions );
+                            const std::vector<const char*>& device_extensions,
+                            bool enable_timeline_semaphore = false );
             logical_device( const logical_device& logical_device ) = delete;
             logical_device( logical_device&& logical_device ) noexcept;
             ~logical_device( );
 
-            VkDevice get()
+            VkDevice get() const
             {
                 return device_handle_;
             }
 
+            bool is_timeline_semaphore_enabled( ) const
+            {
+                return is_timeline_semaphore_enabled_;
+            }
+
+            const VkPhysicalDeviceFeatures& get_enabled_features( ) const
+            {
+                return enabled_features_;
+            }
+
             void wait_idle();
 
+            PFN_vkVoidFunction get_proc_address( const char* name ) const;
+
             logical_device& operator=( const logical_device& logical_device ) = delete;
             logical_device& operator=( logical_device&& logical_device ) noexcept;
 
@@ -38,6 +53,7 @@ namespace vk
 
             VkCommandPool create_command_pool( VkCommandPoolCreateInfo& create_info ) const;
             VkCommandPool destroy_command_pool( VkCommandPool& command_pool_handle ) const;
+            void reset_command_pool( VkCommandPool& command_pool_handle, VkCommandPoolResetFlags flags ) const;
 
             VkCommandBuffer* allocate_command_buffers( VkCommandBufferAllocateInfo& allocate_info, uint32_t count ) const;
             VkCommandBuffer* free_command_buffers( const VkCommandPool& command_pool_handle, VkCommandBuffer* command_buffer_handles, uint32_t count ) const;
@@ -50,6 +66,7 @@ namespace vk
 
             void wait_for_fences( VkFence* p_fence_handle, uint32_t fence_count, VkBool32 wait_all, uint64_t timeout ) const;
             void reset_fences( VkFence* p_fence_handle, uint32_t fence_count ) const;
+            VkResult get_fence_status( VkFence fence_handle ) const;
 
             VkSwapchainKHR create_swapchain( VkSwapchainCreateInfoKHR& create_info ) const;
             VkSwapchainKHR destroy_swapchain( VkSwapchainKHR& swapchain_handle ) const;
@@ -74,6 +91,7 @@ namespace vk
 
             VkPipelineCache create_pipeline_cache( VkPipelineCacheCreateInfo& create_info ) const;
             VkPipelineCache destroy_pipeline_cache( VkPipelineCache& pipeline_cache_handle ) const;
+            std::vector<char> get_pipeline_cache_data( VkPipelineCache pipeline_cache_handle ) const;
 
             VkPipeline create_compute_pipeline( VkPipelineCache pipeline_cache_handle, VkComputePipelineCreateInfo& create_info ) const;
             VkPipeline create_graphics_pipeline( VkPipelineCache pipeline_cache_handle, VkGraphicsPipelineCreateInfo& create_info ) const;
@@ -87,10 +105,16 @@ namespace vk
 
             VkMemoryRequirements get_buffer_memory_requirements( VkBuffer& buffer_handle ) const;
 
+            VkImage create_image( VkImageCreateInfo& create_info ) const;
+            VkImage destroy_image( VkImage& image_handle ) const;
+
+            VkMemoryRequirements get_image_memory_requirements( VkImage& image_handle ) const;
+
             VkDeviceMemory allocate_memory( VkMemoryAllocateInfo& allocate_info ) const;
             VkDeviceMemory free_memory( VkDeviceMemory& memory_handle ) const;
 
             void bind_buffer_memory( VkBuffer& buffer_handle, VkDeviceMemory& memory_handle, VkDeviceSize& offset ) const;
+            void bind_image_memory( VkImage& image_handle, VkDeviceMemory& memory_handle, VkDeviceSize& offset ) const;
 
             void map_memory( VkDeviceMemory& memory_handle, VkDeviceSize offset, VkDeviceSize& size, VkMemoryMapFlags flags, void **pp_data ) const;
             void unmap_memory( VkDeviceMemory& memory_handle ) const;
@@ -107,8 +131,17 @@ namespace vk
             VkDescriptorPool create_descriptor_pool( VkDescriptorPoolCreateInfo& create_info ) const;
             VkDescriptorPool destroy_descriptor_pool( VkDescriptorPool& descriptor_pool_handle ) const;
 
+            VkQueryPool create_query_pool( VkQueryPoolCreateInfo& create_info ) const;
+            VkQueryPool destroy_query_pool( VkQueryPool& query_pool_handle ) const;
+
+            VkResult get_query_pool_results( VkQueryPool query_pool_handle, uint32_t first_query, uint32_t query_count,
+                                             size_t data_size, void* p_data, VkDeviceSize stride, VkQueryResultFlags flags ) const;
+
         private:
             VkDevice device_handle_ = VK_NULL_HANDLE;
+
+            bool is_timeline_semaphore_enabled_ = false;
+            VkPhysicalDeviceFeatures enabled_features_ = {};
         };
     }
 }
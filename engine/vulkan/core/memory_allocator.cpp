@@ -0,0 +1,310 @@
+/*!
+ *
+ */
+
+#include <algorithm>
+#include <iterator>
+
+#include "memory_allocator.h"
+#include "../../utils/exception/vulkan_exception.h"
+
+namespace vk
+{
+    namespace core
+    {
+        memory_allocator::memory_allocator( const logical_device* p_logical_device, const physical_device& physical_device,
+                                            VkDeviceSize block_size )
+            :
+            p_logical_device_( p_logical_device ),
+            memory_properties_( physical_device.get_memory_properties() ),
+            buffer_image_granularity_( physical_device.get_properties().limits.bufferImageGranularity ),
+            block_size_( block_size )
+        {
+        }
+        memory_allocator::memory_allocator( memory_allocator&& memory_allocator ) noexcept
+        {
+            *this = std::move( memory_allocator );
+        }
+        memory_allocator::~memory_allocator( )
+        {
+            destroy_blocks( );
+        }
+
+        helpers::memory_allocation
+        memory_allocator::allocate( const VkMemoryRequirements& requirements, VkMemoryPropertyFlags properties,
+                                    bool is_optimal_image )
+        {
+            VkDeviceSize size = requirements.size;
+            VkDeviceSize alignment = requirements.alignment;
+
+            /*
+             * Optimal images are padded out to whole granularity pages so they can never
+             * alias a page used by a linear resource within the same block.
+             */
+            if( is_optimal_image )
+            {
+                alignment = std::max( alignment, buffer_image_granularity_ );
+                size = ( size + buffer_image_granularity_ - 1 ) & ~( buffer_image_granularity_ - 1 );
+            }
+
+            helpers::memory_allocation allocation = {};
+            allocation.memory_type_index = find_memory_type( requirements.memoryTypeBits, properties );
+            allocation.size = size;
+
+            std::lock_guard<std::mutex> lock( mutex_ );
+
+            auto& blocks = blocks_[allocation.memory_type_index];
+
+            bool found = false;
+            for( uint32_t i = 0; i < blocks.size() && !found; ++i )
+            {
+                if( blocks[i].memory_handle != VK_NULL_HANDLE &&
+                    try_allocate_from_block( blocks[i], size, alignment, allocation.offset ) )
+                {
+                    allocation.block_index = i;
+                    found = true;
+                }
+            }
+
+            if( !found )
+            {
+                allocation.block_index = create_block( allocation.memory_type_index, std::max( size, block_size_ ) );
+
+                if( !try_allocate_from_block( blocks[allocation.block_index], size, alignment, allocation.offset ) )
+                    throw vulkan_exception{ "Failed to sub-allocate from a fresh memory block.", __FILE__, __LINE__ };
+            }
+
+            auto& block = blocks[allocation.block_index];
+
+            allocation.memory_handle = block.memory_handle;
+
+            if( block.p_mapped_data != nullptr )
+                allocation.p_mapped_data = static_cast<char*>( block.p_mapped_data ) + allocation.offset;
+
+            return allocation;
+        }
+        helpers::memory_allocation
+        memory_allocator::allocate_buffer_memory( VkBuffer& buffer_handle, VkMemoryPropertyFlags properties )
+        {
+            auto allocation = allocate( p_logical_device_->get_buffer_memory_requirements( buffer_handle ), properties );
+
+            p_logical_device_->bind_buffer_memory( buffer_handle, allocation.memory_handle, allocation.offset );
+
+            return allocation;
+        }
+        helpers::memory_allocation
+        memory_allocator::allocate_image_memory( VkImage& image_handle, VkMemoryPropertyFlags properties )
+        {
+            auto allocation = allocate( p_logical_device_->get_image_memory_requirements( image_handle ), properties, true );
+
+            p_logical_device_->bind_image_memory( image_handle, allocation.memory_handle, allocation.offset );
+
+            return allocation;
+        }
+
+        void
+        memory_allocator::free( helpers::memory_allocation& allocation )
+        {
+            if( allocation.memory_handle == VK_NULL_HANDLE )
+                return;
+
+            std::lock_guard<std::mutex> lock( mutex_ );
+
+            auto& block = blocks_[allocation.memory_type_index][allocation.block_index];
+
+            auto begin = allocation.offset;
+            auto end = allocation.offset + allocation.size;
+
+            auto next = block.free_ranges.lower_bound( begin );
+            if( next != block.free_ranges.end() && next->first == end )
+            {
+                end += next->second;
+                next = block.free_ranges.erase( next );
+            }
+
+            if( next != block.free_ranges.begin() )
+            {
+                auto previous = std::prev( next );
+                if( previous->first + previous->second == begin )
+                {
+                    begin = previous->first;
+                    block.free_ranges.erase( previous );
+                }
+            }
+
+            block.free_ranges.emplace( begin, end - begin );
+
+            block.used -= allocation.size;
+            --block.allocation_count;
+
+            /*
+             * Oversized blocks were made for a single allocation, give them back straight away.
+             */
+            if( block.allocation_count == 0 && block.size > block_size_ )
+            {
+                if( block.p_mapped_data != nullptr )
+                    p_logical_device_->unmap_memory( block.memory_handle );
+
+                block.memory_handle = p_logical_device_->free_memory( block.memory_handle );
+                block.p_mapped_data = nullptr;
+                block.free_ranges.clear();
+            }
+
+            allocation = {};
+        }
+
+        uint32_t
+        memory_allocator::find_memory_type( uint32_t type_filter, VkMemoryPropertyFlags properties ) const
+        {
+            for( uint32_t i = 0; i < memory_properties_.memoryTypeCount; ++i )
+            {
+                if( ( type_filter & ( 1 << i ) ) && ( memory_properties_.memoryTypes[i].propertyFlags & properties ) == properties )
+                {
+                    return i;
+                }
+            }
+
+            throw vulkan_exception{ "Failed to find a suitable memory type.", __FILE__, __LINE__ };
+        }
+
+        helpers::memory_statistics
+        memory_allocator::get_statistics( ) const
+        {
+            std::lock_guard<std::mutex> lock( mutex_ );
+
+            helpers::memory_statistics statistics = {};
+            statistics.device_allocation_count = device_allocation_count_;
+
+            for( const auto& blocks : blocks_ )
+            {
+                for( const auto& block : blocks )
+                {
+                    if( block.memory_handle == VK_NULL_HANDLE )
+                        continue;
+
+                    ++statistics.block_count;
+                    statistics.allocation_count += block.allocation_count;
+                    statistics.reserved_bytes += block.size;
+                    statistics.used_bytes += block.used;
+                }
+            }
+
+            return statistics;
+        }
+
+        memory_allocator&
+        memory_allocator::operator=( memory_allocator&& memory_allocator ) noexcept
+        {
+            if( this != &memory_allocator )
+            {
+                destroy_blocks( );
+
+                blocks_ = std::move( memory_allocator.blocks_ );
+                for( auto& blocks : memory_allocator.blocks_ )
+                    blocks.clear();
+
+                memory_properties_ = memory_allocator.memory_properties_;
+                buffer_image_granularity_ = memory_allocator.buffer_image_granularity_;
+                block_size_ = memory_allocator.block_size_;
+
+                device_allocation_count_ = memory_allocator.device_allocation_count_;
+                memory_allocator.device_allocation_count_ = 0;
+
+                p_logical_device_ = memory_allocator.p_logical_device_;
+            }
+
+            return *this;
+        }
+
+        bool
+        memory_allocator::try_allocate_from_block( memory_block& block, VkDeviceSize size, VkDeviceSize alignment,
+                                                   VkDeviceSize& offset )
+        {
+            for( auto it = block.free_ranges.begin(); it != block.free_ranges.end(); ++it )
+            {
+                auto range_offset = it->first;
+                auto range_size = it->second;
+
+                auto aligned_offset = ( range_offset + alignment - 1 ) / alignment * alignment;
+                auto padding = aligned_offset - range_offset;
+
+                if( padding + size > range_size )
+                    continue;
+
+                block.free_ranges.erase( it );
+
+                if( padding > 0 )
+                    block.free_ranges.emplace( range_offset, padding );
+
+                if( padding + size < range_size )
+                    block.free_ranges.emplace( aligned_offset + size, range_size - padding - size );
+
+                block.used += size;
+                ++block.allocation_count;
+
+                offset = aligned_offset;
+
+                return true;
+            }
+
+            return false;
+        }
+
+        uint32_t
+        memory_allocator::create_block( uint32_t memory_type_index, VkDeviceSize size )
+        {
+            VkMemoryAllocateInfo allocate_info = {};
+            allocate_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+            allocate_info.allocationSize = size;
+            allocate_info.memoryTypeIndex = memory_type_index;
+
+            memory_block block = {};
+            block.memory_handle = p_logical_device_->allocate_memory( allocate_info );
+            block.size = size;
+            block.free_ranges.emplace( 0, size );
+
+            ++device_allocation_count_;
+
+            if( memory_properties_.memoryTypes[memory_type_index].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT )
+            {
+                VkDeviceSize map_size = VK_WHOLE_SIZE;
+                p_logical_device_->map_memory( block.memory_handle, 0, map_size, 0, &block.p_mapped_data );
+            }
+
+            auto& blocks = blocks_[memory_type_index];
+
+            for( uint32_t i = 0; i < blocks.size(); ++i )
+            {
+                if( blocks[i].memory_handle == VK_NULL_HANDLE )
+                {
+                    blocks[i] = std::move( block );
+                    return i;
+                }
+            }
+
+            blocks.emplace_back( std::move( block ) );
+
+            return static_cast<uint32_t>( blocks.size() - 1 );
+        }
+
+        void
+        memory_allocator::destroy_blocks( )
+        {
+            for( auto& blocks : blocks_ )
+            {
+                for( auto& block : blocks )
+                {
+                    if( block.memory_handle == VK_NULL_HANDLE )
+                        continue;
+
+                    if( block.p_mapped_data != nullptr )
+                        p_logical_device_->unmap_memory( block.memory_handle );
+
+                    block.memory_handle = p_logical_device_->free_memory( block.memory_handle );
+                }
+
+                blocks.clear();
+            }
+        }
+    }
+}
@@ -0,0 +1,83 @@
+/*!
+ * @brief Hands out sub-ranges of large VkDeviceMemory blocks, one set
+ * of blocks per memory type. Host visible blocks stay mapped for their
+ * whole lifetime.
+ */
+
+#ifndef PROJEKT_MEMORY_ALLOCATOR_H
+#define PROJEKT_MEMORY_ALLOCATOR_H
+
+#include <array>
+#include <map>
+#include <mutex>
+#include <vector>
+
+#include <vulkan/vulkan.h>
+
+#include "logical_device.h"
+#include "../helpers/memory_allocation.h"
+
+namespace vk
+{
+    namespace core
+    {
+        class memory_allocator
+        {
+        public:
+            memory_allocator( ) = default;
+            memory_allocator( const logical_device* p_logical_device, const physical_device& physical_device,
+                              VkDeviceSize block_size = 64 * 1024 * 1024 );
+            memory_allocator( const memory_allocator& memory_allocator ) = delete;
+            memory_allocator( memory_allocator&& memory_allocator ) noexcept;
+            ~memory_allocator( );
+
+            helpers::memory_allocation allocate( const VkMemoryRequirements& requirements, VkMemoryPropertyFlags properties,
+                                                 bool is_optimal_image = false );
+            helpers::memory_allocation allocate_buffer_memory( VkBuffer& buffer_handle, VkMemoryPropertyFlags properties );
+            helpers::memory_allocation allocate_image_memory( VkImage& image_handle, VkMemoryPropertyFlags properties );
+
+            void free( helpers::memory_allocation& allocation );
+
+            uint32_t find_memory_type( uint32_t type_filter, VkMemoryPropertyFlags properties ) const;
+
+            helpers::memory_statistics get_statistics( ) const;
+
+            memory_allocator& operator=( const memory_allocator& memory_allocator ) = delete;
+            memory_allocator& operator=( memory_allocator&& memory_allocator ) noexcept;
+
+        private:
+            struct memory_block
+            {
+                VkDeviceMemory memory_handle = VK_NULL_HANDLE;
+                VkDeviceSize size = 0;
+                VkDeviceSize used = 0;
+
+                void* p_mapped_data = nullptr;
+
+                uint32_t allocation_count = 0;
+
+                std::map<VkDeviceSize, VkDeviceSize> free_ranges;
+            };
+
+            bool try_allocate_from_block( memory_block& block, VkDeviceSize size, VkDeviceSize alignment,
+                                          VkDeviceSize& offset );
+            uint32_t create_block( uint32_t memory_type_index, VkDeviceSize size );
+            void destroy_blocks( );
+
+        private:
+            const logical_device* p_logical_device_ = nullptr;
+
+            VkPhysicalDeviceMemoryProperties memory_properties_ = {};
+            VkDeviceSize buffer_image_granularity_ = 1;
+            VkDeviceSize block_size_ = 0;
+
+            std::array<std::vector<memory_block>, VK_MAX_MEMORY_TYPES> blocks_;
+
+            uint64_t device_allocation_count_ = 0;
+
+            mutable std::mutex mutex_;
+        };
+    }
+}
+
+#endif //PROJEKT_MEMORY_ALLOCATOR_H
@@ -4,10 +4,12 @@
 
 #include <vector>
 #include <set>
+#include <string>
 #include <iostream>
 
 #include "physical_device.h"
 #include "../graphics/surface.h"
+#include "../helpers/timeline_semaphore_types.h"
 #include "../../utils/exception/vulkan_exception.h"
 
 namespace vk
@@ -27,6 +29,8 @@ namespace vk
                 }
             }
 
+            find_transfer_queue_family( physical_device_handle_ );
+
             std::cout << "Physical device found:" << std::endl;
 
             vkGetPhysicalDeviceProperties( physical_device_handle_, &physical_device_properties_ );
@@ -47,6 +51,37 @@ namespace vk
                 }
             }
 
+            find_transfer_queue_family( physical_device_handle_ );
+
+            std::cout << "Physical device found:" << std::endl;
+
+            vkGetPhysicalDeviceProperties( physical_device_handle_, &physical_device_properties_ );
+
+            std::cout << "\tName: " << physical_device_properties_.deviceName << "\n\tDriver: " << physical_device_properties_.driverVersion;
+            std::cout << "\n\tVendor: " << physical_device_properties_.vendorID << std::endl;
+        }
+        physical_device::physical_device( instance& instance, const helpers::queue_family_type& type )
+        {
+            auto devices = instance.enumerate_physical_devices();
+
+            for( auto& device : devices )
+            {
+                bool is_suitable = type == helpers::queue_family_type::e_graphics
+                                   ? is_device_suitable_for_offscreen( device )
+                                   : is_device_suitable_for_compute( device );
+
+                if( is_suitable )
+                {
+                    physical_device_handle_ = device;
+                    break;
+                }
+            }
+
+            if( physical_device_handle_ == VK_NULL_HANDLE )
+                throw vulkan_exception{ "Failed to find a suitable physical device.", __FILE__, __LINE__ };
+
+            find_transfer_queue_family( physical_device_handle_ );
+
             std::cout << "Physical device found:" << std::endl;
 
             vkGetPhysicalDeviceProperties( physical_device_handle_, &physical_device_properties_ );
@@ -65,6 +100,57 @@ namespace vk
             *this = std::move( physical_device );
         }
 
+        VkPhysicalDeviceFeatures
+        physical_device::get_supported_features( ) const
+        {
+            VkPhysicalDeviceFeatures supported_features = {};
+            vkGetPhysicalDeviceFeatures( physical_device_handle_, &supported_features );
+
+            return supported_features;
+        }
+
+        bool
+        physical_device::is_extension_supported( const char* extension_name ) const
+        {
+            uint32_t extension_count = 0;
+            vkEnumerateDeviceExtensionProperties( physical_device_handle_, nullptr, &extension_count, nullptr );
+
+            std::vector<VkExtensionProperties> extension_properties( extension_count );
+            vkEnumerateDeviceExtensionProperties( physical_device_handle_, nullptr, &extension_count, extension_properties.data() );
+
+            for( const auto& extension_property : extension_properties )
+            {
+                if( std::string( extension_property.extensionName ) == extension_name )
+                    return true;
+            }
+
+            return false;
+        }
+        bool
+        physical_device::is_timeline_semaphore_supported( ) const
+        {
+            if( !is_extension_supported( VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME ) )
+                return false;
+
+            /*
+             * vkGetPhysicalDeviceFeatures2 is core in 1.1, which the instance asks for, but it is only
+             * valid on devices that support 1.1 as well.
+             */
+            if( physical_device_properties_.apiVersion < VK_API_VERSION_1_1 )
+                return false;
+
+            VkPhysicalDeviceTimelineSemaphoreFeaturesKHR timeline_semaphore_features = {};
+            timeline_semaphore_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES_KHR;
+
+            VkPhysicalDeviceFeatures2 features = {};
+            features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+            features.pNext = &timeline_semaphore_features;
+
+            vkGetPhysicalDeviceFeatures2( physical_device_handle_, &features );
+
+            return timeline_semaphore_features.timelineSemaphore == VK_TRUE;
+        }
+
         void
         physical_device::set_device_features( VkPhysicalDeviceFeatures& physical_device_features ) noexcept
         {
@@ -80,6 +166,8 @@ namespace vk
                 return queue_family_indices_.present_family;
             else if( type == helpers::queue_family_type::e_compute )
                 return queue_family_indices_.compute_family;
+            else if( type == helpers::queue_family_type::e_transfer )
+                return queue_family_indices_.transfer_family;
 
             return -1;
         }
@@ -97,6 +185,9 @@ namespace vk
             if( queue_family_indices_.compute_family >= 0 )
                 unique_queue_family.emplace( queue_family_indices_.compute_family );
 
+            if( queue_family_indices_.transfer_family >= 0 )
+                unique_queue_family.emplace( queue_family_indices_.transfer_family );
+
             return unique_queue_family;
         }
 
@@ -151,6 +242,14 @@ namespace vk
             return queue_family_indices_.is_compute_complete();
         }
 
+        bool
+        physical_device::is_device_suitable_for_offscreen( VkPhysicalDevice& physical_device_handle ) noexcept
+        {
+            find_offscreen_queue_families( physical_device_handle );
+
+            return queue_family_indices_.graphics_family >= 0 && queue_family_indices_.compute_family >= 0;
+        }
+
         void
         physical_device::find_compute_queue_family( VkPhysicalDevice &physical_device_handle ) noexcept
         {
@@ -173,6 +272,60 @@ namespace vk
             }
         }
 
+        void
+        physical_device::find_offscreen_queue_families( VkPhysicalDevice& physical_device_handle ) noexcept
+        {
+            uint32_t queue_family_count = 0;
+            vkGetPhysicalDeviceQueueFamilyProperties( physical_device_handle, &queue_family_count, nullptr );
+
+            std::vector<VkQueueFamilyProperties> queue_family_properties( queue_family_count );
+            vkGetPhysicalDeviceQueueFamilyProperties( physical_device_handle, &queue_family_count, queue_family_properties.data() );
+
+            int i = 0;
+            for( const auto& queue_family_property : queue_family_properties )
+            {
+                if( queue_family_property.queueCount > 0 && queue_family_property.queueFlags & VK_QUEUE_GRAPHICS_BIT )
+                    queue_family_indices_.graphics_family = i;
+
+                if( queue_family_property.queueCount > 0 && queue_family_property.queueFlags & VK_QUEUE_COMPUTE_BIT )
+                    queue_family_indices_.compute_family = i;
+
+                if( queue_family_indices_.graphics_family >= 0 && queue_family_indices_.compute_family >= 0 )
+                    break;
+
+                ++i;
+            }
+        }
+
+        void
+        physical_device::find_transfer_queue_family( VkPhysicalDevice& physical_device_handle ) noexcept
+        {
+            uint32_t queue_family_count = 0;
+            vkGetPhysicalDeviceQueueFamilyProperties( physical_device_handle, &queue_family_count, nullptr );
+
+            std::vector<VkQueueFamilyProperties> queue_family_properties( queue_family_count );
+            vkGetPhysicalDeviceQueueFamilyProperties( physical_device_handle, &queue_family_count, queue_family_properties.data() );
+
+            queue_family_indices_.transfer_family = queue_family_indices_.graphics_family >= 0
+                                                    ? queue_family_indices_.graphics_family
+                                                    : queue_family_indices_.compute_family;
+
+            int i = 0;
+            for( const auto& queue_family_property : queue_family_properties )
+            {
+                auto flags = queue_family_property.queueFlags;
+
+                if( queue_family_property.queueCount > 0 && flags & VK_QUEUE_TRANSFER_BIT &&
+                    !( flags & VK_QUEUE_GRAPHICS_BIT ) && !( flags & VK_QUEUE_COMPUTE_BIT ) )
+                {
+                    queue_family_indices_.transfer_family = i;
+                    break;
+                }
+
+                ++i;
+            }
+        }
+
         void
         physical_device::find_queue_families( const graphics::surface& surface, VkPhysicalDevice& physical_device_handle ) noexcept
         {
@@ -230,6 +383,21 @@ namespace vk
             return mem_properties;
         }
 
+        uint32_t physical_device::get_timestamp_valid_bits( const helpers::queue_family_type& type ) const
+        {
+            auto family_index = get_queue_family_index( type );
+            if( family_index < 0 )
+                return 0;
+
+            uint32_t queue_family_count = 0;
+            vkGetPhysicalDeviceQueueFamilyProperties( physical_device_handle_, &queue_family_count, nullptr );
+
+            std::vector<VkQueueFamilyProperties> queue_family_properties( queue_family_count );
+            vkGetPhysicalDeviceQueueFamilyProperties( physical_device_handle_, &queue_family_count, queue_family_properties.data() );
+
+            return queue_family_properties[family_index].timestampValidBits;
+        }
+
         void physical_device::check_surface_present_support( const graphics::surface& surface )
         {
             uint32_t queue_family_count = 0;
@@ -25,6 +25,10 @@ namespace vk
             physical_device() = default;
             explicit physical_device( instance& p_instance );
             physical_device( instance& instance, const graphics::surface& surface );
+            /*
+             * Picks a device with a graphics queue without asking for present support, for offscreen rendering.
+             */
+            physical_device( instance& instance, const helpers::queue_family_type& type );
             physical_device( instance& instance, VkPhysicalDeviceFeatures& physical_Device_features );
             physical_device( const physical_device& physical_device ) = delete;
             physical_device( physical_device&& physical_device ) noexcept;
@@ -46,6 +50,10 @@ namespace vk
             std::set<int> unique_queue_families() noexcept;
 
             const VkPhysicalDeviceFeatures& features() noexcept;
+            VkPhysicalDeviceFeatures get_supported_features( ) const;
+
+            bool is_extension_supported( const char* extension_name ) const;
+            bool is_timeline_semaphore_supported( ) const;
 
             physical_device& operator=( const physical_device& physical_device ) = delete;
             physical_device& operator=( physical_device&& physical_device ) noexcept;
@@ -54,13 +62,26 @@ namespace vk
 
             VkPhysicalDeviceMemoryProperties get_memory_properties( ) const;
 
+            const VkPhysicalDeviceProperties& get_properties( ) const
+            {
+                return physical_device_properties_;
+            }
+
+            /*
+             * 0 means the queue family doesn't support timestamps at all.
+             */
+            uint32_t get_timestamp_valid_bits( const helpers::queue_family_type& type ) const;
+
             void check_surface_present_support( const graphics::surface& surface );
 
         private:
             bool is_device_suitable( const graphics::surface& surface, VkPhysicalDevice& physical_device_handle ) noexcept;
             bool is_device_suitable_for_compute( VkPhysicalDevice &physical_device_handle ) noexcept;
+            bool is_device_suitable_for_offscreen( VkPhysicalDevice& physical_device_handle ) noexcept;
             void find_queue_families( const graphics::surface& surface, VkPhysicalDevice& physical_device_handle ) noexcept;
             void find_compute_queue_family( VkPhysicalDevice& physical_device_handle ) noexcept;
+            void find_offscreen_queue_families( VkPhysicalDevice& physical_device_handle ) noexcept;
+            void find_transfer_queue_family( VkPhysicalDevice& physical_device_handle ) noexcept;
 
 
         private:
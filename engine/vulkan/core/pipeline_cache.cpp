@@ -0,0 +1,164 @@
+/*!
+ *
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#include "pipeline_cache.h"
+#include "../../utils/exception/exception.h"
+
+namespace vk
+{
+    namespace core
+    {
+        constexpr uint32_t PIPELINE_CACHE_MAGIC = 0x504B5043; // "PKPC"
+
+        pipeline_cache::pipeline_cache( const logical_device* p_logical_device, const physical_device& physical_device,
+                                        const std::string& filepath )
+            :
+            p_logical_device_( p_logical_device ),
+            properties_( physical_device.get_properties() ),
+            filepath_( filepath )
+        {
+            auto data = load( );
+
+            is_warm_ = !data.empty();
+            loaded_size_ = data.size();
+
+            VkPipelineCacheCreateInfo create_info = {};
+            create_info.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+            create_info.initialDataSize = data.size();
+            create_info.pInitialData = data.empty() ? nullptr : data.data();
+
+            pipeline_cache_handle_ = p_logical_device_->create_pipeline_cache( create_info );
+        }
+        pipeline_cache::pipeline_cache( pipeline_cache&& pipeline_cache ) noexcept
+        {
+            *this = std::move( pipeline_cache );
+        }
+        pipeline_cache::~pipeline_cache( )
+        {
+            if( pipeline_cache_handle_ != VK_NULL_HANDLE )
+                pipeline_cache_handle_ = p_logical_device_->destroy_pipeline_cache( pipeline_cache_handle_ );
+        }
+
+        void
+        pipeline_cache::save( ) const
+        {
+            if( pipeline_cache_handle_ == VK_NULL_HANDLE )
+                return;
+
+            auto data = p_logical_device_->get_pipeline_cache_data( pipeline_cache_handle_ );
+
+            file_header header = {};
+            header.magic = PIPELINE_CACHE_MAGIC;
+            header.driver_version = properties_.driverVersion;
+            header.vendor_id = properties_.vendorID;
+            header.device_id = properties_.deviceID;
+            std::memcpy( header.pipeline_cache_uuid, properties_.pipelineCacheUUID, VK_UUID_SIZE );
+            header.data_size = data.size();
+
+            /*
+             * Written to a temporary file first so a crash mid-write never leaves a torn cache behind.
+             */
+            const auto temporary_filepath = filepath_ + ".tmp";
+            {
+                std::ofstream file( temporary_filepath, std::ios::binary | std::ios::trunc );
+
+                if( !file.good() )
+                    throw exception{ "Error opening file: " + temporary_filepath + ".", __FILE__, __LINE__ };
+
+                file.write( reinterpret_cast<const char*>( &header ), sizeof( header ) );
+                file.write( data.data(), data.size() );
+
+                if( !file.good() )
+                    throw exception{ "Error writing file: " + temporary_filepath + ".", __FILE__, __LINE__ };
+            }
+
+            std::remove( filepath_.c_str() );
+            if( std::rename( temporary_filepath.c_str(), filepath_.c_str() ) != 0 )
+                throw exception{ "Error replacing file: " + filepath_ + ".", __FILE__, __LINE__ };
+        }
+
+        pipeline_cache&
+        pipeline_cache::operator=( pipeline_cache&& pipeline_cache ) noexcept
+        {
+            if( this != &pipeline_cache )
+            {
+                if( pipeline_cache_handle_ != VK_NULL_HANDLE )
+                    pipeline_cache_handle_ = p_logical_device_->destroy_pipeline_cache( pipeline_cache_handle_ );
+
+                pipeline_cache_handle_ = pipeline_cache.pipeline_cache_handle_;
+                pipeline_cache.pipeline_cache_handle_ = VK_NULL_HANDLE;
+
+                properties_ = pipeline_cache.properties_;
+                filepath_ = std::move( pipeline_cache.filepath_ );
+
+                is_warm_ = pipeline_cache.is_warm_;
+                loaded_size_ = pipeline_cache.loaded_size_;
+
+                p_logical_device_ = pipeline_cache.p_logical_device_;
+            }
+
+            return *this;
+        }
+
+        std::vector<char>
+        pipeline_cache::load( ) const
+        {
+            std::ifstream file( filepath_, std::ios::binary | std::ios::ate );
+
+            if( !file.good() )
+                return { };
+
+            const auto file_size = static_cast<uint64_t>( file.tellg() );
+            file.seekg( 0 );
+
+            file_header header = {};
+            if( file_size < sizeof( header ) || !file.read( reinterpret_cast<char*>( &header ), sizeof( header ) ) )
+                return { };
+
+            if( header.magic != PIPELINE_CACHE_MAGIC || header.data_size != file_size - sizeof( header ) )
+                return { };
+
+            std::vector<char> data( static_cast<size_t>( header.data_size ) );
+            if( !file.read( data.data(), data.size() ) )
+                return { };
+
+            if( !is_valid( header, data ) )
+                return { };
+
+            return data;
+        }
+
+        bool
+        pipeline_cache::is_valid( const file_header& header, const std::vector<char>& data ) const
+        {
+            if( header.driver_version != properties_.driverVersion ||
+                header.vendor_id != properties_.vendorID ||
+                header.device_id != properties_.deviceID ||
+                std::memcmp( header.pipeline_cache_uuid, properties_.pipelineCacheUUID, VK_UUID_SIZE ) != 0 )
+            {
+                return false;
+            }
+
+            /*
+             * The driver's own header must agree as well, a mismatch there means the blob is not ours to trust.
+             */
+            constexpr size_t vulkan_header_size = 16 + VK_UUID_SIZE;
+            if( data.size() < vulkan_header_size )
+                return false;
+
+            uint32_t vulkan_header[4];
+            std::memcpy( vulkan_header, data.data(), sizeof( vulkan_header ) );
+
+            return vulkan_header[0] >= vulkan_header_size &&
+                   vulkan_header[1] == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+                   vulkan_header[2] == properties_.vendorID &&
+                   vulkan_header[3] == properties_.deviceID &&
+                   std::memcmp( data.data() + sizeof( vulkan_header ), properties_.pipelineCacheUUID, VK_UUID_SIZE ) == 0;
+        }
+    }
+}
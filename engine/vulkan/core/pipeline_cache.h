@@ -0,0 +1,87 @@
+/*!
+ * @brief A VkPipelineCache backed by a file on disk. The file is only
+ * trusted when it was written for the same device, pipeline cache UUID
+ * and driver version, otherwise the cache starts out empty.
+ */
+
+#ifndef PROJEKT_PIPELINE_CACHE_H
+#define PROJEKT_PIPELINE_CACHE_H
+
+#include <string>
+#include <vector>
+
+#include <vulkan/vulkan.h>
+
+#include "logical_device.h"
+#include "physical_device.h"
+
+namespace vk
+{
+    namespace core
+    {
+        class pipeline_cache
+        {
+        public:
+            pipeline_cache( ) = default;
+            pipeline_cache( const logical_device* p_logical_device, const physical_device& physical_device,
+                            const std::string& filepath );
+            pipeline_cache( const pipeline_cache& pipeline_cache ) = delete;
+            pipeline_cache( pipeline_cache&& pipeline_cache ) noexcept;
+            ~pipeline_cache( );
+
+            void save( ) const;
+
+            VkPipelineCache get() const
+            {
+                return pipeline_cache_handle_;
+            }
+
+            /*
+             * Whether the cache was seeded with valid data from disk.
+             */
+            bool is_warm() const
+            {
+                return is_warm_;
+            }
+
+            size_t get_loaded_size() const
+            {
+                return loaded_size_;
+            }
+
+            pipeline_cache& operator=( const pipeline_cache& pipeline_cache ) = delete;
+            pipeline_cache& operator=( pipeline_cache&& pipeline_cache ) noexcept;
+
+        private:
+            /*
+             * Written in front of the driver's blob. The Vulkan header holds the
+             * device and UUID but not the driver version, so it is stored here.
+             */
+            struct file_header
+            {
+                uint32_t magic;
+                uint32_t driver_version;
+                uint32_t vendor_id;
+                uint32_t device_id;
+                uint8_t pipeline_cache_uuid[VK_UUID_SIZE];
+                uint64_t data_size;
+            };
+
+            std::vector<char> load( ) const;
+            bool is_valid( const file_header& header, const std::vector<char>& data ) const;
+
+        private:
+            const logical_device* p_logical_device_ = nullptr;
+
+            VkPipelineCache pipeline_cache_handle_ = VK_NULL_HANDLE;
+
+            VkPhysicalDeviceProperties properties_ = {};
+            std::string filepath_;
+
+            bool is_warm_ = false;
+            size_t loaded_size_ = 0;
+        };
+    }
+}
+
+#endif //PROJEKT_PIPELINE_CACHE_H
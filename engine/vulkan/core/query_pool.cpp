@@ -0,0 +1,65 @@
+/*!
+ *
+ */
+
+#include "query_pool.h"
+
+namespace vk
+{
+    namespace core
+    {
+        query_pool::query_pool( const logical_device* p_logical_device, VkQueryType query_type, uint32_t count )
+            :
+            p_logical_device_( p_logical_device ),
+            count_( count )
+        {
+            VkQueryPoolCreateInfo create_info = {};
+            create_info.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+            create_info.queryType = query_type;
+            create_info.queryCount = count_;
+
+            query_pool_handle_ = p_logical_device_->create_query_pool( create_info );
+        }
+        query_pool::query_pool( query_pool&& query_pool ) noexcept
+        {
+            *this = std::move( query_pool );
+        }
+        query_pool::~query_pool( )
+        {
+            if( query_pool_handle_ != VK_NULL_HANDLE )
+                query_pool_handle_ = p_logical_device_->destroy_query_pool( query_pool_handle_ );
+        }
+
+        bool
+        query_pool::get_results( uint32_t first_query, uint32_t query_count, std::vector<uint64_t>& results ) const
+        {
+            results.resize( query_count );
+
+            auto result = p_logical_device_->get_query_pool_results( query_pool_handle_, first_query, query_count,
+                                                                     results.size() * sizeof( uint64_t ), results.data(),
+                                                                     sizeof( uint64_t ), VK_QUERY_RESULT_64_BIT );
+
+            return result == VK_SUCCESS;
+        }
+
+        query_pool&
+        query_pool::operator=( query_pool&& query_pool ) noexcept
+        {
+            if( this != &query_pool )
+            {
+                if( query_pool_handle_ != VK_NULL_HANDLE )
+                    query_pool_handle_ = p_logical_device_->destroy_query_pool( query_pool_handle_ );
+
+                p_logical_device_ = query_pool.p_logical_device_;
+
+                query_pool_handle_ = query_pool.query_pool_handle_;
+                query_pool.query_pool_handle_ = VK_NULL_HANDLE;
+
+                count_ = query_pool.count_;
+                query_pool.count_ = 0;
+            }
+
+            return *this;
+        }
+    }
+}
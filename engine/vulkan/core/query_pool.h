@@ -0,0 +1,55 @@
+/*!
+ *
+ */
+
+#ifndef PROJEKT_QUERY_POOL_H
+#define PROJEKT_QUERY_POOL_H
+
+#include <cstdint>
+#include <vector>
+
+#include <vulkan/vulkan.h>
+
+#include "logical_device.h"
+
+namespace vk
+{
+    namespace core
+    {
+        class query_pool
+        {
+        public:
+            query_pool( ) = default;
+            query_pool( const logical_device* p_logical_device, VkQueryType query_type, uint32_t count );
+            query_pool( const query_pool& query_pool ) = delete;
+            query_pool( query_pool&& query_pool ) noexcept;
+            ~query_pool( );
+
+            /*
+             * Never waits, false is returned when any of the queries isn't available yet.
+             */
+            bool get_results( uint32_t first_query, uint32_t query_count, std::vector<uint64_t>& results ) const;
+
+            VkQueryPool get( ) const
+            {
+                return query_pool_handle_;
+            }
+
+            uint32_t get_count( ) const
+            {
+                return count_;
+            }
+
+            query_pool& operator=( const query_pool& query_pool ) = delete;
+            query_pool& operator=( query_pool&& query_pool ) noexcept;
+
+        private:
+            const logical_device* p_logical_device_ = nullptr;
+
+            VkQueryPool query_pool_handle_ = VK_NULL_HANDLE;
+            uint32_t count_ = 0;
+        };
+    }
+}
+
+#endif //PROJEKT_QUERY_POOL_H
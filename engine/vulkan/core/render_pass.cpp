@@ -36,17 +36,23 @@ namespace vk
         }
         render_pass::render_pass( const logical_device* p_logical_device, const graphics::swapchain& swapchain )
             :
-            p_logical_device_( p_logical_device )
+            render_pass( p_logical_device, swapchain.get_format(), VK_IMAGE_LAYOUT_PRESENT_SRC_KHR )
+        {
+        }
+        render_pass::render_pass( const logical_device* p_logical_device, VkFormat colour_format, VkImageLayout final_layout )
+            :
+            p_logical_device_( p_logical_device ),
+            colour_format_( colour_format )
         {
             VkAttachmentDescription colour_attachment = {};
-            colour_attachment.format = swapchain.get_format();
-            colour_attachment.samples = VK_SAMPLE_COUNT_1_BIT;
+            colour_attachment.format = colour_format_;
+            colour_attachment.samples = samples_;
             colour_attachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
             colour_attachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
             colour_attachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
             colour_attachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
             colour_attachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-            colour_attachment.finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+            colour_attachment.finalLayout = final_layout;
 
             VkAttachmentReference colour_attachment_ref = {};
             colour_attachment_ref.attachment = 0;
@@ -98,6 +104,9 @@ namespace vk
                 render_pass_handle_ = render_pass.render_pass_handle_;
                 render_pass.render_pass_handle_ = VK_NULL_HANDLE;
 
+                colour_format_ = render_pass.colour_format_;
+                samples_ = render_pass.samples_;
+
                 p_logical_device_ = render_pass.p_logical_device_;
             }
 
@@ -21,6 +21,7 @@ namespace vk
             render_pass() = default;
             render_pass( const logical_device* p_logical_device );
             render_pass( const logical_device* p_logical_device, const graphics::swapchain& swapchain );
+            render_pass( const logical_device* p_logical_device, VkFormat colour_format, VkImageLayout final_layout );
             render_pass( const render_pass& render_pass ) = delete;
             render_pass( render_pass&& render_pass ) noexcept;
             ~render_pass( );
@@ -30,6 +31,16 @@ namespace vk
                 return render_pass_handle_;
             }
 
+            VkFormat get_format() const
+            {
+                return colour_format_;
+            }
+
+            VkSampleCountFlagBits get_samples() const
+            {
+                return samples_;
+            }
+
             render_pass& operator=( const render_pass& renderPass ) = delete;
             render_pass& operator=( render_pass&& render_pass ) noexcept;
 
@@ -37,6 +48,8 @@ namespace vk
            const logical_device* p_logical_device_;
 
            VkRenderPass render_pass_handle_ = VK_NULL_HANDLE;
+           VkFormat colour_format_ = VK_FORMAT_UNDEFINED;
+           VkSampleCountFlagBits samples_ = VK_SAMPLE_COUNT_1_BIT;
         };
     }
 }
@@ -16,12 +16,13 @@ namespace vk
         {
             auto shader_code = read_from_binary_file( shader_location );
 
-            VkShaderModuleCreateInfo create_info = {};
-            create_info.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
-            create_info.codeSize = shader_code.size();
-            create_info.pCode = reinterpret_cast<const uint32_t*>( shader_code.data() );
-
-            shader_module_handle_ = p_logical_device_->create_shader_module( create_info );
+            create( shader_code.data(), shader_code.size() );
+        }
+        shader_module::shader_module( const logical_device* p_logical_device, const char* p_code, size_t code_size )
+            :
+            p_logical_device_( p_logical_device )
+        {
+            create( p_code, code_size );
         }
         shader_module::shader_module( shader_module&& shader_module ) noexcept
         {
@@ -61,5 +62,16 @@ namespace vk
 
             return *this;
         }
+
+        void
+        shader_module::create( const char* p_code, size_t code_size )
+        {
+            VkShaderModuleCreateInfo create_info = {};
+            create_info.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+            create_info.codeSize = code_size;
+            create_info.pCode = reinterpret_cast<const uint32_t*>( p_code );
+
+            shader_module_handle_ = p_logical_device_->create_shader_module( create_info );
+        }
     }
 }
@@ -16,6 +16,10 @@ namespace vk
         public:
             shader_module( ) = default;
             shader_module( const logical_device* p_logical_device, const std::string& shader_location );
+            /*
+             * Builds the module straight from SPIR-V already in memory.
+             */
+            shader_module( const logical_device* p_logical_device, const char* p_code, size_t code_size );
             shader_module( const shader_module& shader_module ) = delete;
             shader_module( shader_module&& shader_module ) noexcept;
             ~shader_module( );
@@ -25,6 +29,9 @@ namespace vk
             shader_module& operator=( const shader_module& shader_module ) = delete;
             shader_module& operator=( shader_module&& shader_module ) noexcept;
 
+        private:
+            void create( const char* p_code, size_t code_size );
+
         private:
             const logical_device* p_logical_device_;
 
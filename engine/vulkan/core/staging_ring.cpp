@@ -0,0 +1,142 @@
+/*!
+ *
+ */
+
+#include <algorithm>
+#include <cstring>
+
+#include "staging_ring.h"
+
+namespace vk
+{
+    namespace core
+    {
+        staging_ring::staging_ring( const logical_device* p_logical_device, memory_allocator* p_memory_allocator,
+                                    const physical_device& physical_device, VkDeviceSize capacity )
+            :
+            buffer_( p_logical_device, p_memory_allocator, capacity, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                     VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT ),
+            capacity_( capacity ),
+            alignment_( std::max<VkDeviceSize>( 4, physical_device.get_properties().limits.optimalBufferCopyOffsetAlignment ) )
+        {
+        }
+        staging_ring::staging_ring( staging_ring&& staging_ring ) noexcept
+        {
+            *this = std::move( staging_ring );
+        }
+
+        bool
+        staging_ring::try_write( const void* p_data, VkDeviceSize size, VkDeviceSize& offset )
+        {
+            if( size == 0 || size > capacity_ )
+                return false;
+
+            if( in_use_ == 0 )
+                head_ = tail_ = 0;
+
+            auto aligned_head = ( head_ + alignment_ - 1 ) / alignment_ * alignment_;
+
+            /*
+             * Free space is [head, capacity) + [0, tail) while the ring hasn't wrapped
+             * and [head, tail) once it has. Bytes skipped at the end of the buffer when
+             * wrapping stay accounted to the region until it is released.
+             */
+            VkDeviceSize consumed = 0;
+            if( head_ > tail_ || in_use_ == 0 )
+            {
+                if( aligned_head + size <= capacity_ )
+                {
+                    offset = aligned_head;
+                    consumed = aligned_head + size - head_;
+                }
+                else if( size <= tail_ )
+                {
+                    offset = 0;
+                    consumed = capacity_ - head_ + size;
+                }
+                else
+                {
+                    return false;
+                }
+            }
+            else
+            {
+                if( aligned_head + size > tail_ )
+                    return false;
+
+                offset = aligned_head;
+                consumed = aligned_head + size - head_;
+            }
+
+            memcpy( static_cast<char*>( buffer_.get_mapped_data() ) + offset, p_data, static_cast<size_t>( size ) );
+
+            head_ = offset + size;
+            in_use_ += consumed;
+            open_bytes_ += consumed;
+
+            return true;
+        }
+
+        void
+        staging_ring::close_region( uint64_t region_id )
+        {
+            if( open_bytes_ == 0 )
+                return;
+
+            region closed = {};
+            closed.id = region_id;
+            closed.end = head_;
+            closed.bytes = open_bytes_;
+
+            regions_.push_back( closed );
+
+            open_bytes_ = 0;
+        }
+        void
+        staging_ring::release_region( uint64_t region_id )
+        {
+            for( auto& region : regions_ )
+            {
+                if( region.id == region_id )
+                    region.is_released = true;
+            }
+
+            /*
+             * Regions are handed back strictly in the order they were written so the
+             * tail never jumps over memory that is still being read.
+             */
+            while( !regions_.empty() && regions_.front().is_released )
+            {
+                tail_ = regions_.front().end;
+                in_use_ -= regions_.front().bytes;
+
+                regions_.pop_front();
+            }
+        }
+
+        staging_ring&
+        staging_ring::operator=( staging_ring&& staging_ring ) noexcept
+        {
+            if( this != &staging_ring )
+            {
+                buffer_ = std::move( staging_ring.buffer_ );
+
+                capacity_ = staging_ring.capacity_;
+                staging_ring.capacity_ = 0;
+
+                alignment_ = staging_ring.alignment_;
+
+                head_ = staging_ring.head_;
+                tail_ = staging_ring.tail_;
+                in_use_ = staging_ring.in_use_;
+                open_bytes_ = staging_ring.open_bytes_;
+
+                regions_ = std::move( staging_ring.regions_ );
+
+                staging_ring.head_ = staging_ring.tail_ = staging_ring.in_use_ = staging_ring.open_bytes_ = 0;
+            }
+
+            return *this;
+        }
+    }
+}
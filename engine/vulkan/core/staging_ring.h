@@ -0,0 +1,82 @@
+/*!
+ * @brief Persistently mapped staging buffer handed out as a ring. Space is
+ * grouped into regions, one per upload batch, and a region only becomes
+ * reusable once the batch that reads from it has been released.
+ */
+
+#ifndef PROJEKT_STAGING_RING_H
+#define PROJEKT_STAGING_RING_H
+
+#include <deque>
+
+#include <vulkan/vulkan.h>
+
+#include "logical_device.h"
+#include "buffer.h"
+#include "memory_allocator.h"
+
+namespace vk
+{
+    namespace core
+    {
+        class staging_ring
+        {
+        public:
+            staging_ring( ) = default;
+            staging_ring( const logical_device* p_logical_device, memory_allocator* p_memory_allocator,
+                          const physical_device& physical_device, VkDeviceSize capacity );
+            staging_ring( const staging_ring& staging_ring ) = delete;
+            staging_ring( staging_ring&& staging_ring ) noexcept;
+            ~staging_ring( ) = default;
+
+            bool try_write( const void* p_data, VkDeviceSize size, VkDeviceSize& offset );
+
+            void close_region( uint64_t region_id );
+            void release_region( uint64_t region_id );
+
+            bool has_open_region( ) const
+            {
+                return open_bytes_ > 0;
+            }
+
+            VkBuffer& get()
+            {
+                return buffer_.get();
+            }
+
+            VkDeviceSize get_capacity() const
+            {
+                return capacity_;
+            }
+
+            staging_ring& operator=( const staging_ring& staging_ring ) = delete;
+            staging_ring& operator=( staging_ring&& staging_ring ) noexcept;
+
+        private:
+            struct region
+            {
+                uint64_t id = 0;
+
+                VkDeviceSize end = 0;
+                VkDeviceSize bytes = 0;
+
+                bool is_released = false;
+            };
+
+        private:
+            buffer buffer_;
+
+            VkDeviceSize capacity_ = 0;
+            VkDeviceSize alignment_ = 1;
+
+            VkDeviceSize head_ = 0;
+            VkDeviceSize tail_ = 0;
+            VkDeviceSize in_use_ = 0;
+            VkDeviceSize open_bytes_ = 0;
+
+            std::deque<region> regions_;
+        };
+    }
+}
+
+#endif //PROJEKT_STAGING_RING_H
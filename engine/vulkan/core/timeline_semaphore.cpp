@@ -0,0 +1,251 @@
+/*!
+ *
+ */
+
+#include <limits>
+
+#include "timeline_semaphore.h"
+#include "../../utils/exception/vulkan_exception.h"
+
+namespace vk
+{
+    namespace core
+    {
+        timeline_semaphore::timeline_semaphore( const logical_device* p_logical_device )
+            :
+            p_logical_device_( p_logical_device )
+        {
+            if( p_logical_device_->is_timeline_semaphore_enabled() )
+            {
+                p_wait_semaphores_ = reinterpret_cast<PFN_vkWaitSemaphoresKHR>(
+                    p_logical_device_->get_proc_address( "vkWaitSemaphoresKHR" ) );
+                p_get_semaphore_counter_value_ = reinterpret_cast<PFN_vkGetSemaphoreCounterValueKHR>(
+                    p_logical_device_->get_proc_address( "vkGetSemaphoreCounterValueKHR" ) );
+
+                if( p_wait_semaphores_ == nullptr || p_get_semaphore_counter_value_ == nullptr )
+                    throw vulkan_exception{ "Failed to load the timeline semaphore entry points.", __FILE__, __LINE__ };
+
+                VkSemaphoreTypeCreateInfoKHR type_create_info = {};
+                type_create_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO_KHR;
+                type_create_info.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE_KHR;
+                type_create_info.initialValue = 0;
+
+                VkSemaphoreCreateInfo create_info = {};
+                create_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+                create_info.pNext = &type_create_info;
+
+                semaphore_handle_ = p_logical_device_->create_semaphores( create_info, 1 );
+                is_timeline_ = true;
+            }
+        }
+        timeline_semaphore::timeline_semaphore( timeline_semaphore&& timeline_semaphore ) noexcept
+        {
+            *this = std::move( timeline_semaphore );
+        }
+        timeline_semaphore::~timeline_semaphore( )
+        {
+            if( semaphore_handle_ != nullptr )
+                semaphore_handle_ = p_logical_device_->destroy_semaphores( semaphore_handle_, 1 );
+        }
+
+        uint64_t
+        timeline_semaphore::submit( queue& queue, VkSubmitInfo& submit_info, const std::vector<timeline_wait>& waits )
+        {
+            const auto value = last_submitted_value_ + 1;
+
+            if( is_timeline_ )
+            {
+                /*
+                 * Binary semaphores already in the submission keep their place, their values are ignored.
+                 */
+                std::vector<VkSemaphore> wait_semaphores( submit_info.pWaitSemaphores, submit_info.pWaitSemaphores + submit_info.waitSemaphoreCount );
+                std::vector<VkPipelineStageFlags> wait_stages( submit_info.pWaitDstStageMask, submit_info.pWaitDstStageMask + submit_info.waitSemaphoreCount );
+                std::vector<uint64_t> wait_values( wait_semaphores.size(), 0 );
+
+                for( const auto& wait : waits )
+                {
+                    if( wait.p_semaphore == nullptr || wait.value == 0 )
+                        continue;
+
+                    wait_semaphores.push_back( wait.p_semaphore->get() );
+                    wait_stages.push_back( wait.stage );
+                    wait_values.push_back( wait.value );
+                }
+
+                std::vector<VkSemaphore> signal_semaphores( submit_info.pSignalSemaphores, submit_info.pSignalSemaphores + submit_info.signalSemaphoreCount );
+                std::vector<uint64_t> signal_values( signal_semaphores.size(), 0 );
+
+                signal_semaphores.push_back( semaphore_handle_[0] );
+                signal_values.push_back( value );
+
+                VkTimelineSemaphoreSubmitInfoKHR timeline_submit_info = {};
+                timeline_submit_info.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO_KHR;
+                timeline_submit_info.pNext = submit_info.pNext;
+                timeline_submit_info.waitSemaphoreValueCount = static_cast<uint32_t>( wait_values.size() );
+                timeline_submit_info.pWaitSemaphoreValues = wait_values.data();
+                timeline_submit_info.signalSemaphoreValueCount = static_cast<uint32_t>( signal_values.size() );
+                timeline_submit_info.pSignalSemaphoreValues = signal_values.data();
+
+                VkSubmitInfo timeline_info = submit_info;
+                timeline_info.pNext = &timeline_submit_info;
+                timeline_info.waitSemaphoreCount = static_cast<uint32_t>( wait_semaphores.size() );
+                timeline_info.pWaitSemaphores = wait_semaphores.data();
+                timeline_info.pWaitDstStageMask = wait_stages.data();
+                timeline_info.signalSemaphoreCount = static_cast<uint32_t>( signal_semaphores.size() );
+                timeline_info.pSignalSemaphores = signal_semaphores.data();
+
+                queue.submit( timeline_info, VK_NULL_HANDLE );
+
+                last_submitted_value_ = value;
+
+                return value;
+            }
+
+            /*
+             * Without timeline semaphores the GPU can't wait on another queue's value, so it is resolved
+             * here before submitting. The signal becomes a fence tagged with the value.
+             */
+            for( const auto& wait : waits )
+            {
+                if( wait.p_semaphore != nullptr )
+                    wait.p_semaphore->wait( wait.value );
+            }
+
+            pending_signal signal;
+            signal.value = value;
+
+            if( !free_fences_.empty() )
+            {
+                signal.fence = std::move( free_fences_.back() );
+                free_fences_.pop_back();
+            }
+            else
+            {
+                signal.fence = fences( p_logical_device_, 1 );
+            }
+
+            signal.fence.reset_fence( 0 );
+
+            queue.submit( submit_info, signal.fence[0] );
+
+            pending_signals_.emplace_back( std::move( signal ) );
+
+            last_submitted_value_ = value;
+
+            return value;
+        }
+
+        bool
+        timeline_semaphore::is_complete( uint64_t value )
+        {
+            if( value <= completed_value_ )
+                return true;
+
+            poll( );
+
+            return value <= completed_value_;
+        }
+        void
+        timeline_semaphore::wait( uint64_t value )
+        {
+            if( value <= completed_value_ )
+                return;
+
+            /*
+             * Nothing else signals this semaphore, waiting on a value that was never submitted would never return.
+             */
+            if( value > last_submitted_value_ )
+                throw vulkan_exception{ "Waiting on a timeline value that has not been submitted.", __FILE__, __LINE__ };
+
+            if( is_timeline_ )
+            {
+                VkSemaphoreWaitInfoKHR wait_info = {};
+                wait_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO_KHR;
+                wait_info.semaphoreCount = 1;
+                wait_info.pSemaphores = semaphore_handle_;
+                wait_info.pValues = &value;
+
+                if( p_wait_semaphores_( p_logical_device_->get(), &wait_info, std::numeric_limits<uint64_t>::max() ) != VK_SUCCESS )
+                    throw vulkan_exception{ "Failed to wait on timeline semaphore.", __FILE__, __LINE__ };
+
+                poll( );
+
+                return;
+            }
+
+            while( !pending_signals_.empty() && pending_signals_.front().value <= value )
+            {
+                auto& signal = pending_signals_.front();
+                signal.fence.wait_for_fence( 0, VK_TRUE, std::numeric_limits<uint64_t>::max() );
+
+                completed_value_ = signal.value;
+
+                free_fences_.emplace_back( std::move( signal.fence ) );
+                pending_signals_.pop_front();
+            }
+        }
+
+        uint64_t
+        timeline_semaphore::get_completed_value( )
+        {
+            poll( );
+
+            return completed_value_;
+        }
+
+        timeline_semaphore&
+        timeline_semaphore::operator=( timeline_semaphore&& timeline_semaphore ) noexcept
+        {
+            if( this != &timeline_semaphore )
+            {
+                if( semaphore_handle_ != nullptr )
+                    semaphore_handle_ = p_logical_device_->destroy_semaphores( semaphore_handle_, 1 );
+
+                semaphore_handle_ = timeline_semaphore.semaphore_handle_;
+                timeline_semaphore.semaphore_handle_ = nullptr;
+
+                is_timeline_ = timeline_semaphore.is_timeline_;
+                timeline_semaphore.is_timeline_ = false;
+
+                last_submitted_value_ = timeline_semaphore.last_submitted_value_;
+                timeline_semaphore.last_submitted_value_ = 0;
+
+                completed_value_ = timeline_semaphore.completed_value_;
+                timeline_semaphore.completed_value_ = 0;
+
+                pending_signals_ = std::move( timeline_semaphore.pending_signals_ );
+                free_fences_ = std::move( timeline_semaphore.free_fences_ );
+
+                p_wait_semaphores_ = timeline_semaphore.p_wait_semaphores_;
+                p_get_semaphore_counter_value_ = timeline_semaphore.p_get_semaphore_counter_value_;
+
+                p_logical_device_ = timeline_semaphore.p_logical_device_;
+            }
+
+            return *this;
+        }
+
+        void
+        timeline_semaphore::poll( )
+        {
+            if( is_timeline_ )
+            {
+                uint64_t value = 0;
+                if( p_get_semaphore_counter_value_( p_logical_device_->get(), semaphore_handle_[0], &value ) != VK_SUCCESS )
+                    throw vulkan_exception{ "Failed to query timeline semaphore value.", __FILE__, __LINE__ };
+
+                completed_value_ = value;
+
+                return;
+            }
+
+            while( !pending_signals_.empty() && pending_signals_.front().fence.is_signaled( 0 ) )
+            {
+                completed_value_ = pending_signals_.front().value;
+
+                free_fences_.emplace_back( std::move( pending_signals_.front().fence ) );
+                pending_signals_.pop_front();
+            }
+        }
+    }
+}
@@ -0,0 +1,101 @@
+/*!
+ * @brief A monotonically increasing 64 bit counter signaled by queue
+ * submissions. Every submission made through it signals the next value,
+ * which the CPU can poll or wait on and other submissions can wait on.
+ * Uses VK_KHR_timeline_semaphore when the device has it enabled, and
+ * otherwise falls back to one fence per submission with the waits
+ * resolved on the CPU.
+ */
+
+#ifndef PROJEKT_TIMELINE_SEMAPHORE_H
+#define PROJEKT_TIMELINE_SEMAPHORE_H
+
+#include <deque>
+#include <vector>
+
+#include <vulkan/vulkan.h>
+
+#include "logical_device.h"
+#include "fences.h"
+#include "queue.h"
+#include "../helpers/timeline_semaphore_types.h"
+
+namespace vk
+{
+    namespace core
+    {
+        class timeline_semaphore;
+
+        struct timeline_wait
+        {
+            timeline_semaphore* p_semaphore = nullptr;
+            uint64_t value = 0;
+            VkPipelineStageFlags stage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+        };
+
+        class timeline_semaphore
+        {
+        public:
+            timeline_semaphore( ) = default;
+            explicit timeline_semaphore( const logical_device* p_logical_device );
+            timeline_semaphore( const timeline_semaphore& timeline_semaphore ) = delete;
+            timeline_semaphore( timeline_semaphore&& timeline_semaphore ) noexcept;
+            ~timeline_semaphore( );
+
+            uint64_t submit( queue& queue, VkSubmitInfo& submit_info, const std::vector<timeline_wait>& waits = { } );
+
+            bool is_complete( uint64_t value );
+            void wait( uint64_t value );
+
+            uint64_t get_completed_value( );
+
+            uint64_t get_last_submitted_value( ) const
+            {
+                return last_submitted_value_;
+            }
+            uint64_t get_next_value( ) const
+            {
+                return last_submitted_value_ + 1;
+            }
+
+            VkSemaphore get( ) const
+            {
+                return semaphore_handle_ != nullptr ? semaphore_handle_[0] : VK_NULL_HANDLE;
+            }
+
+            bool is_timeline( ) const
+            {
+                return is_timeline_;
+            }
+
+            timeline_semaphore& operator=( const timeline_semaphore& timeline_semaphore ) = delete;
+            timeline_semaphore& operator=( timeline_semaphore&& timeline_semaphore ) noexcept;
+
+        private:
+            struct pending_signal
+            {
+                uint64_t value = 0;
+                fences fence;
+            };
+
+            void poll( );
+
+        private:
+            const logical_device* p_logical_device_ = nullptr;
+
+            VkSemaphore* semaphore_handle_ = nullptr;
+            bool is_timeline_ = false;
+
+            uint64_t last_submitted_value_ = 0;
+            uint64_t completed_value_ = 0;
+
+            std::deque<pending_signal> pending_signals_;
+            std::vector<fences> free_fences_;
+
+            PFN_vkWaitSemaphoresKHR p_wait_semaphores_ = nullptr;
+            PFN_vkGetSemaphoreCounterValueKHR p_get_semaphore_counter_value_ = nullptr;
+        };
+    }
+}
+
+#endif //PROJEKT_TIMELINE_SEMAPHORE_H
@@ -0,0 +1,308 @@
+/*!
+ *
+ */
+
+#include <cstring>
+
+#include "upload_manager.h"
+#include "../../utils/exception/vulkan_exception.h"
+
+namespace vk
+{
+    namespace core
+    {
+        upload_manager::upload_manager( const logical_device* p_logical_device, memory_allocator* p_memory_allocator,
+                                        const physical_device& physical_device, VkDeviceSize staging_capacity )
+            :
+            p_logical_device_( p_logical_device ),
+            p_memory_allocator_( p_memory_allocator )
+        {
+            command_pool_ = command_pool( physical_device, p_logical_device_, helpers::queue_family_type::e_transfer,
+                                          VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT );
+            transfer_queue_ = queue( *p_logical_device_, physical_device, helpers::queue_family_type::e_transfer, 0 );
+            staging_ring_ = staging_ring( p_logical_device_, p_memory_allocator_, physical_device, staging_capacity );
+            timeline_ = timeline_semaphore( p_logical_device_ );
+
+            auto graphics_family = static_cast<uint32_t>( physical_device.get_queue_family_index( helpers::queue_family_type::e_graphics ) );
+            auto transfer_family = static_cast<uint32_t>( physical_device.get_queue_family_index( helpers::queue_family_type::e_transfer ) );
+
+            /*
+             * Resources are shared concurrently between the two families rather than
+             * going through ownership transfers, only when they actually differ.
+             */
+            queue_family_indices_.push_back( graphics_family );
+            if( transfer_family != graphics_family )
+                queue_family_indices_.push_back( transfer_family );
+        }
+        upload_manager::upload_manager( upload_manager&& upload_manager ) noexcept
+        {
+            *this = std::move( upload_manager );
+        }
+        upload_manager::~upload_manager( )
+        {
+            wait_all( );
+        }
+
+        upload_ticket
+        upload_manager::upload_buffer( VkBuffer& dst_buffer, const void* p_data, VkDeviceSize size, VkDeviceSize dst_offset )
+        {
+            buffer_copy copy = {};
+            stage( p_data, size, copy.src_buffer, copy.region.srcOffset );
+            copy.dst_buffer = dst_buffer;
+            copy.region.dstOffset = dst_offset;
+            copy.region.size = size;
+
+            pending_buffer_copies_.push_back( copy );
+
+            return timeline_.get_next_value();
+        }
+        upload_ticket
+        upload_manager::upload_image( VkImage& dst_image, const void* p_data, VkDeviceSize size, uint32_t width, uint32_t height )
+        {
+            image_copy copy = {};
+            stage( p_data, size, copy.src_buffer, copy.region.bufferOffset );
+            copy.dst_image = dst_image;
+            copy.region.bufferRowLength = 0;
+            copy.region.bufferImageHeight = 0;
+            copy.region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            copy.region.imageSubresource.mipLevel = 0;
+            copy.region.imageSubresource.baseArrayLayer = 0;
+            copy.region.imageSubresource.layerCount = 1;
+            copy.region.imageOffset = { 0, 0, 0 };
+            copy.region.imageExtent = { width, height, 1 };
+
+            pending_image_copies_.push_back( copy );
+
+            return timeline_.get_next_value();
+        }
+
+        upload_ticket
+        upload_manager::flush( )
+        {
+            retire( );
+
+            if( pending_buffer_copies_.empty() && pending_image_copies_.empty() )
+                return timeline_.get_last_submitted_value();
+
+            upload_batch batch;
+            if( !free_batches_.empty() )
+            {
+                batch = std::move( free_batches_.back() );
+                free_batches_.pop_back();
+            }
+            else
+            {
+                batch.command_buffer = command_buffers( &command_pool_, 1 );
+            }
+
+            batch.ticket = timeline_.get_next_value();
+
+            record( batch );
+
+            staging_ring_.close_region( batch.ticket );
+
+            batch.dedicated_staging_buffers = std::move( pending_dedicated_staging_buffers_ );
+            pending_dedicated_staging_buffers_.clear();
+            pending_buffer_copies_.clear();
+            pending_image_copies_.clear();
+
+            VkSubmitInfo submit_info = {};
+            submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+            submit_info.commandBufferCount = 1;
+            submit_info.pCommandBuffers = &batch.command_buffer[0];
+
+            auto ticket = timeline_.submit( transfer_queue_, submit_info );
+
+            in_flight_batches_.emplace_back( std::move( batch ) );
+
+            return ticket;
+        }
+
+        bool
+        upload_manager::is_complete( upload_ticket ticket )
+        {
+            retire( );
+
+            /*
+             * Anything still pending on the CPU side has not been submitted yet.
+             */
+            if( ticket > timeline_.get_last_submitted_value() )
+                return false;
+
+            return timeline_.is_complete( ticket );
+        }
+        void
+        upload_manager::wait( upload_ticket ticket )
+        {
+            if( ticket > timeline_.get_last_submitted_value() )
+                flush( );
+
+            timeline_.wait( ticket );
+
+            retire( );
+        }
+
+        upload_manager&
+        upload_manager::operator=( upload_manager&& upload_manager ) noexcept
+        {
+            if( this != &upload_manager )
+            {
+                wait_all( );
+                in_flight_batches_.clear();
+                free_batches_.clear();
+
+                /*
+                 * Recorded batches point at the command pool they were allocated from,
+                 * so they can't follow it into a new owner.
+                 */
+                upload_manager.wait_all( );
+                upload_manager.in_flight_batches_.clear();
+                upload_manager.free_batches_.clear();
+
+                p_logical_device_ = upload_manager.p_logical_device_;
+                p_memory_allocator_ = upload_manager.p_memory_allocator_;
+
+                command_pool_ = std::move( upload_manager.command_pool_ );
+                transfer_queue_ = std::move( upload_manager.transfer_queue_ );
+                staging_ring_ = std::move( upload_manager.staging_ring_ );
+                timeline_ = std::move( upload_manager.timeline_ );
+
+                queue_family_indices_ = std::move( upload_manager.queue_family_indices_ );
+
+                pending_dedicated_staging_buffers_ = std::move( upload_manager.pending_dedicated_staging_buffers_ );
+                pending_buffer_copies_ = std::move( upload_manager.pending_buffer_copies_ );
+                pending_image_copies_ = std::move( upload_manager.pending_image_copies_ );
+            }
+
+            return *this;
+        }
+
+        void
+        upload_manager::stage( const void* p_data, VkDeviceSize size, VkBuffer& src_buffer, VkDeviceSize& src_offset )
+        {
+            if( size <= staging_ring_.get_capacity() )
+            {
+                /*
+                 * When the ring is full, push what is pending to the GPU and wait on the
+                 * oldest batch still in flight until enough space has been handed back.
+                 */
+                while( !staging_ring_.try_write( p_data, size, src_offset ) )
+                {
+                    if( staging_ring_.has_open_region() )
+                        flush( );
+
+                    if( in_flight_batches_.empty() )
+                        throw vulkan_exception{ "Staging ring has no space left to reclaim.", __FILE__, __LINE__ };
+
+                    timeline_.wait( in_flight_batches_.front().ticket );
+                    retire( );
+                }
+
+                src_buffer = staging_ring_.get();
+            }
+            else
+            {
+                buffer staging_buffer( p_logical_device_, p_memory_allocator_, size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                                       VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT );
+
+                memcpy( staging_buffer.get_mapped_data(), p_data, static_cast<size_t>( size ) );
+
+                src_buffer = staging_buffer.get();
+                src_offset = 0;
+
+                pending_dedicated_staging_buffers_.emplace_back( std::move( staging_buffer ) );
+            }
+        }
+
+        void
+        upload_manager::record( upload_batch& batch )
+        {
+            auto& command_buffer = batch.command_buffer;
+
+            command_buffer.begin( VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT, 0 );
+
+            for( auto& copy : pending_buffer_copies_ )
+            {
+                command_buffer.copy_buffer( copy.src_buffer, copy.dst_buffer,
+                                            1, &copy.region, 0 );
+            }
+
+            if( !pending_image_copies_.empty() )
+            {
+                std::vector<VkImageMemoryBarrier> barriers( pending_image_copies_.size() );
+                for( size_t i = 0; i < pending_image_copies_.size(); ++i )
+                {
+                    auto& barrier = barriers[i];
+                    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+                    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+                    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+                    barrier.image = pending_image_copies_[i].dst_image;
+                    barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+                    barrier.subresourceRange.baseMipLevel = 0;
+                    barrier.subresourceRange.levelCount = 1;
+                    barrier.subresourceRange.baseArrayLayer = 0;
+                    barrier.subresourceRange.layerCount = 1;
+                    barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+                    barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+                    barrier.srcAccessMask = 0;
+                    barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+                }
+
+                command_buffer.pipeline_barrier( VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                                 0, nullptr, 0, nullptr,
+                                                 static_cast<uint32_t>( barriers.size() ), barriers.data(), 0 );
+
+                for( auto& copy : pending_image_copies_ )
+                {
+                    command_buffer.copy_buffer_to_image( copy.src_buffer, copy.dst_image,
+                                                         VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &copy.region, 0 );
+                }
+
+                /*
+                 * The transfer queue may not support shader stages, the graphics queue
+                 * only ever samples these after waiting on the batch's timeline value.
+                 */
+                for( auto& barrier : barriers )
+                {
+                    barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+                    barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+                    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+                    barrier.dstAccessMask = 0;
+                }
+
+                command_buffer.pipeline_barrier( VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                                                 0, nullptr, 0, nullptr,
+                                                 static_cast<uint32_t>( barriers.size() ), barriers.data(), 0 );
+            }
+
+            command_buffer.end( 0 );
+        }
+
+        void
+        upload_manager::retire( )
+        {
+            for( auto it = in_flight_batches_.begin(); it != in_flight_batches_.end(); )
+            {
+                if( timeline_.is_complete( it->ticket ) )
+                {
+                    it->dedicated_staging_buffers.clear();
+                    staging_ring_.release_region( it->ticket );
+                    free_batches_.emplace_back( std::move( *it ) );
+                    it = in_flight_batches_.erase( it );
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+        }
+        void
+        upload_manager::wait_all( )
+        {
+            if( !in_flight_batches_.empty() )
+                timeline_.wait( in_flight_batches_.back().ticket );
+
+            retire( );
+        }
+    }
+}
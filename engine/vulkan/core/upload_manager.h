@@ -0,0 +1,113 @@
+/*!
+ * @brief Batches staging copies into a single submission on the transfer
+ * queue. Each batch signals the next value of a timeline semaphore, and
+ * that value is the ticket handed back, so it can be polled, waited on by
+ * the CPU or chained into another queue's submission. Source data goes through a shared staging
+ * ring, only uploads larger than the ring get a buffer of their own.
+ */
+
+#ifndef PROJEKT_UPLOAD_MANAGER_H
+#define PROJEKT_UPLOAD_MANAGER_H
+
+#include <vector>
+
+#include <vulkan/vulkan.h>
+
+#include "logical_device.h"
+#include "buffer.h"
+#include "command_pool.h"
+#include "command_buffers.h"
+#include "memory_allocator.h"
+#include "queue.h"
+#include "staging_ring.h"
+#include "timeline_semaphore.h"
+
+namespace vk
+{
+    namespace core
+    {
+        using upload_ticket = uint64_t;
+
+        class upload_manager
+        {
+        public:
+            upload_manager( ) = default;
+            upload_manager( const logical_device* p_logical_device, memory_allocator* p_memory_allocator,
+                            const physical_device& physical_device, VkDeviceSize staging_capacity = 32 * 1024 * 1024 );
+            upload_manager( const upload_manager& upload_manager ) = delete;
+            upload_manager( upload_manager&& upload_manager ) noexcept;
+            ~upload_manager( );
+
+            upload_ticket upload_buffer( VkBuffer& dst_buffer, const void* p_data, VkDeviceSize size, VkDeviceSize dst_offset = 0 );
+            upload_ticket upload_image( VkImage& dst_image, const void* p_data, VkDeviceSize size, uint32_t width, uint32_t height );
+
+            upload_ticket flush( );
+
+            bool is_complete( upload_ticket ticket );
+            void wait( upload_ticket ticket );
+
+            timeline_semaphore& get_timeline( )
+            {
+                return timeline_;
+            }
+
+            const std::vector<uint32_t>& get_queue_family_indices( ) const
+            {
+                return queue_family_indices_;
+            }
+
+            upload_manager& operator=( const upload_manager& upload_manager ) = delete;
+            upload_manager& operator=( upload_manager&& upload_manager ) noexcept;
+
+        private:
+            struct buffer_copy
+            {
+                VkBuffer src_buffer;
+                VkBuffer dst_buffer;
+                VkBufferCopy region;
+            };
+
+            struct image_copy
+            {
+                VkBuffer src_buffer;
+                VkImage dst_image;
+                VkBufferImageCopy region;
+            };
+
+            struct upload_batch
+            {
+                upload_ticket ticket = 0;
+
+                command_buffers command_buffer;
+
+                std::vector<buffer> dedicated_staging_buffers;
+            };
+
+            void stage( const void* p_data, VkDeviceSize size, VkBuffer& src_buffer, VkDeviceSize& src_offset );
+            void record( upload_batch& batch );
+            void retire( );
+            void wait_all( );
+
+        private:
+            const logical_device* p_logical_device_ = nullptr;
+            memory_allocator* p_memory_allocator_ = nullptr;
+
+            command_pool command_pool_;
+            queue transfer_queue_;
+
+            std::vector<uint32_t> queue_family_indices_;
+
+            staging_ring staging_ring_;
+            timeline_semaphore timeline_;
+
+            std::vector<buffer> pending_dedicated_staging_buffers_;
+            std::vector<buffer_copy> pending_buffer_copies_;
+            std::vector<image_copy> pending_image_copies_;
+
+            std::vector<upload_batch> in_flight_batches_;
+            std::vector<upload_batch> free_batches_;
+        };
+    }
+}
+
+#endif //PROJEKT_UPLOAD_MANAGER_H
@@ -0,0 +1,32 @@
+/*!
+ *
+ */
+
+#ifndef PROJEKT_DRAW_CALL_H
+#define PROJEKT_DRAW_CALL_H
+
+#include <cstdint>
+
+namespace vk
+{
+    namespace graphics
+    {
+        /*
+         * Draws with the renderer's own pipeline rather than one requested from the pipeline builder.
+         */
+        constexpr const uint32_t DEFAULT_PIPELINE_ID = 0xFFFFFFFF;
+
+        struct draw_call
+        {
+            uint32_t pipeline_id = DEFAULT_PIPELINE_ID;
+
+            uint32_t index_count = 0;
+            uint32_t instance_count = 1;
+            uint32_t first_index = 0;
+            int32_t vertex_offset = 0;
+            uint32_t first_instance = 0;
+        };
+    }
+}
+
+#endif //PROJEKT_DRAW_CALL_H
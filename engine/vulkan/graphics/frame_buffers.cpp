@@ -12,17 +12,23 @@ namespace vk
         frame_buffers::frame_buffers( const core::logical_device* p_logical_device,
                                       const core::render_pass& render_pass, const swapchain& swapchain, uint32_t count )
             :
+            frame_buffers( p_logical_device, render_pass, swapchain.get_image_views(), swapchain.get_extent(), count )
+        {
+        }
+        frame_buffers::frame_buffers( const core::logical_device* p_logical_device, const core::render_pass& render_pass,
+                                      const VkImageView* image_view_handles, const VkExtent2D& extent, uint32_t count )
+            :
             p_logical_device_( p_logical_device ),
             count_( count )
         {
             VkFramebufferCreateInfo create_info = {};
             create_info.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
             create_info.renderPass = render_pass.get();
-            create_info.width = swapchain.get_extent().width;
-            create_info.height = swapchain.get_extent().height;
+            create_info.width = extent.width;
+            create_info.height = extent.height;
             create_info.layers = 1;
 
-            frame_buffer_handles_ = p_logical_device_->create_frame_buffers( swapchain.get_image_views(), create_info, count_ );
+            frame_buffer_handles_ = p_logical_device_->create_frame_buffers( image_view_handles, create_info, count_ );
         }
         frame_buffers::frame_buffers( frame_buffers&& frame_buffers ) noexcept
         {
@@ -21,6 +21,8 @@ namespace vk
             frame_buffers( ) = default;
             frame_buffers( const core::logical_device* p_logical_device, const core::render_pass& render_pass,
                            const swapchain& swapchain, uint32_t count );
+            frame_buffers( const core::logical_device* p_logical_device, const core::render_pass& render_pass,
+                           const VkImageView* image_view_handles, const VkExtent2D& extent, uint32_t count );
             frame_buffers( const frame_buffers& frame_buffers ) = delete;
             frame_buffers( frame_buffers&& frame_buffers ) noexcept;
             ~frame_buffers( );
@@ -0,0 +1,39 @@
+/*!
+ * @brief Everything a single frame in flight owns. A context is only
+ * reused once the timeline value its last submission signaled has been
+ * reached, at which point all of it can be reset and rewritten.
+ */
+
+#ifndef PROJEKT_FRAME_CONTEXT_H
+#define PROJEKT_FRAME_CONTEXT_H
+
+#include <cstdint>
+
+#include "../core/frame_command_pool.h"
+#include "../core/semaphores.h"
+
+namespace vk
+{
+    namespace graphics
+    {
+        struct frame_context
+        {
+            /*
+             * Also selects the frame's slice of the uniform ring and its worker command pools.
+             */
+            uint32_t index = 0;
+
+            core::frame_command_pool command_pool;
+
+            core::semaphores image_available_semaphore;
+            core::semaphores render_finished_semaphore;
+
+            /*
+             * Value of the frame timeline signaled by the last submission recorded with this context.
+             */
+            uint64_t timeline_value = 0;
+        };
+    }
+}
+
+#endif //PROJEKT_FRAME_CONTEXT_H
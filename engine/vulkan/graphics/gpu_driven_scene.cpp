@@ -0,0 +1,179 @@
+/*!
+ *
+ */
+
+#include "gpu_driven_scene.h"
+#include "../../utils/exception/vulkan_exception.h"
+
+namespace vk
+{
+    namespace graphics
+    {
+        constexpr const uint32_t CULL_GROUP_SIZE = 64;
+
+        gpu_driven_scene::gpu_driven_scene( const core::logical_device* p_logical_device, core::memory_allocator* p_memory_allocator,
+                                            const core::pipeline_cache& pipeline_cache,
+                                            core::upload_manager& upload_manager, const std::string& cull_shader_path,
+                                            uint32_t max_object_count, PFN_vkCmdDrawIndexedIndirectCountKHR p_draw_indirect_count,
+                                            bool has_multi_draw_indirect )
+            :
+            p_logical_device_( p_logical_device ),
+            p_memory_allocator_( p_memory_allocator ),
+            max_object_count_( max_object_count ),
+            p_draw_indirect_count_( p_draw_indirect_count ),
+            has_multi_draw_indirect_( has_multi_draw_indirect )
+        {
+            const auto& queue_family_indices = upload_manager.get_queue_family_indices();
+
+            object_buffer_ = core::buffer( p_logical_device, p_memory_allocator, sizeof( object_data ) * max_object_count_,
+                                           VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                                           VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, queue_family_indices );
+            draw_command_buffer_ = core::buffer( p_logical_device, p_memory_allocator, sizeof( VkDrawIndexedIndirectCommand ) * max_object_count_,
+                                                 VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
+                                                 VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT );
+            draw_count_buffer_ = core::buffer( p_logical_device, p_memory_allocator, sizeof( uint32_t ),
+                                               VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT |
+                                               VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                                               VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT );
+
+            cull_kernel_ = compute::compute_kernel( p_logical_device, pipeline_cache, cull_shader_path, 3, sizeof( cull_constants ) );
+            cull_kernel_.bind( {
+                { object_buffer_.get(), 0, VK_WHOLE_SIZE },
+                { draw_command_buffer_.get(), 0, VK_WHOLE_SIZE },
+                { draw_count_buffer_.get(), 0, VK_WHOLE_SIZE }
+            } );
+        }
+        gpu_driven_scene::gpu_driven_scene( gpu_driven_scene&& gpu_driven_scene ) noexcept
+        {
+            *this = std::move( gpu_driven_scene );
+        }
+
+        core::upload_ticket
+        gpu_driven_scene::set_objects( core::upload_manager& upload_manager, core::deletion_queue& deletion_queue,
+                                       const std::vector<object_data>& objects )
+        {
+            if( objects.size() > max_object_count_ )
+                throw vulkan_exception{ "Object count exceeds the capacity of the GPU driven scene.", __FILE__, __LINE__ };
+
+            object_count_ = static_cast<uint32_t>( objects.size() );
+
+            if( objects.empty() )
+                return upload_manager.flush( );
+
+            deletion_queue.retire( std::move( object_buffer_ ) );
+
+            object_buffer_ = core::buffer( p_logical_device_, p_memory_allocator_, sizeof( object_data ) * max_object_count_,
+                                           VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                                           VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, upload_manager.get_queue_family_indices() );
+
+            cull_kernel_.bind( {
+                { object_buffer_.get(), 0, VK_WHOLE_SIZE },
+                { draw_command_buffer_.get(), 0, VK_WHOLE_SIZE },
+                { draw_count_buffer_.get(), 0, VK_WHOLE_SIZE }
+            }, deletion_queue );
+
+            return upload_manager.upload_buffer( object_buffer_.get(), objects.data(), sizeof( object_data ) * objects.size() );
+        }
+
+        void
+        gpu_driven_scene::record_culling( core::command_buffers& command_buffers, uint32_t index, const glm::mat4& view_projection )
+        {
+            if( object_count_ == 0 )
+                return;
+
+            cull_constants constants = {};
+            constants.object_count = object_count_;
+            constants.is_compacting = p_draw_indirect_count_ != nullptr ? 1 : 0;
+
+            /*
+             * Gribb-Hartmann plane extraction, with the near plane at z = 0 as Vulkan
+             * clip space goes from 0 to w.
+             */
+            auto row = [&view_projection]( int i )
+            {
+                return glm::vec4( view_projection[0][i], view_projection[1][i], view_projection[2][i], view_projection[3][i] );
+            };
+
+            constants.frustum_planes[0] = row( 3 ) + row( 0 );
+            constants.frustum_planes[1] = row( 3 ) - row( 0 );
+            constants.frustum_planes[2] = row( 3 ) + row( 1 );
+            constants.frustum_planes[3] = row( 3 ) - row( 1 );
+            constants.frustum_planes[4] = row( 2 );
+            constants.frustum_planes[5] = row( 3 ) - row( 2 );
+
+            for( auto& plane : constants.frustum_planes )
+                plane /= glm::length( glm::vec3( plane ) );
+
+            /*
+             * The previous frame may still be drawing from these buffers on the same queue.
+             */
+            command_buffers.buffer_barrier( draw_command_buffer_.get(), VK_ACCESS_INDIRECT_COMMAND_READ_BIT, VK_ACCESS_SHADER_WRITE_BIT,
+                                            VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, index );
+            command_buffers.buffer_barrier( draw_count_buffer_.get(), VK_ACCESS_INDIRECT_COMMAND_READ_BIT, VK_ACCESS_TRANSFER_WRITE_BIT,
+                                            VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, index );
+
+            command_buffers.fill_buffer( draw_count_buffer_.get(), 0, sizeof( uint32_t ), 0, index );
+            command_buffers.buffer_barrier( draw_count_buffer_.get(), VK_ACCESS_TRANSFER_WRITE_BIT,
+                                            VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT,
+                                            VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, index );
+
+            cull_kernel_.record( command_buffers, index, ( object_count_ + CULL_GROUP_SIZE - 1 ) / CULL_GROUP_SIZE, 1, 1, &constants );
+
+            command_buffers.buffer_barrier( draw_command_buffer_.get(), VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_INDIRECT_COMMAND_READ_BIT,
+                                            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT, index );
+            command_buffers.buffer_barrier( draw_count_buffer_.get(), VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_INDIRECT_COMMAND_READ_BIT,
+                                            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT, index );
+        }
+        void
+        gpu_driven_scene::record_draw( core::command_buffers& command_buffers, uint32_t index )
+        {
+            if( object_count_ == 0 )
+                return;
+
+            auto stride = static_cast<uint32_t>( sizeof( VkDrawIndexedIndirectCommand ) );
+
+            if( p_draw_indirect_count_ != nullptr )
+            {
+                command_buffers.draw_indexed_indirect_count( p_draw_indirect_count_, draw_command_buffer_.get(), 0,
+                                                             draw_count_buffer_.get(), 0, object_count_, stride, index );
+            }
+            else if( has_multi_draw_indirect_ )
+            {
+                // Culled objects are left in place with an instance count of zero.
+                command_buffers.draw_indexed_indirect( draw_command_buffer_.get(), 0, object_count_, stride, index );
+            }
+            else
+            {
+                for( uint32_t i = 0; i < object_count_; ++i )
+                    command_buffers.draw_indexed_indirect( draw_command_buffer_.get(), i * stride, 1, stride, index );
+            }
+        }
+
+        gpu_driven_scene&
+        gpu_driven_scene::operator=( gpu_driven_scene&& gpu_driven_scene ) noexcept
+        {
+            if( this != &gpu_driven_scene )
+            {
+                p_logical_device_ = gpu_driven_scene.p_logical_device_;
+                p_memory_allocator_ = gpu_driven_scene.p_memory_allocator_;
+
+                cull_kernel_ = std::move( gpu_driven_scene.cull_kernel_ );
+
+                object_buffer_ = std::move( gpu_driven_scene.object_buffer_ );
+                draw_command_buffer_ = std::move( gpu_driven_scene.draw_command_buffer_ );
+                draw_count_buffer_ = std::move( gpu_driven_scene.draw_count_buffer_ );
+
+                max_object_count_ = gpu_driven_scene.max_object_count_;
+                gpu_driven_scene.max_object_count_ = 0;
+
+                object_count_ = gpu_driven_scene.object_count_;
+                gpu_driven_scene.object_count_ = 0;
+
+                p_draw_indirect_count_ = gpu_driven_scene.p_draw_indirect_count_;
+                has_multi_draw_indirect_ = gpu_driven_scene.has_multi_draw_indirect_;
+            }
+
+            return *this;
+        }
+    }
+}
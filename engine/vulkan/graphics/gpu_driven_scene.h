@@ -0,0 +1,95 @@
+/*!
+ * @brief Object list culled and turned into indirect draws on the GPU. A
+ * compute pass tests every object's bounding sphere against the view
+ * frustum and writes one VkDrawIndexedIndirectCommand per visible object,
+ * so recording the frame costs the same whatever the object count.
+ */
+
+#ifndef PROJEKT_GPU_DRIVEN_SCENE_H
+#define PROJEKT_GPU_DRIVEN_SCENE_H
+
+#include <string>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <vulkan/vulkan.h>
+
+#include "object_data.h"
+#include "../core/logical_device.h"
+#include "../core/buffer.h"
+#include "../core/command_buffers.h"
+#include "../core/memory_allocator.h"
+#include "../core/upload_manager.h"
+#include "../core/deletion_queue.h"
+#include "../compute/compute_kernel.h"
+
+namespace vk
+{
+    namespace graphics
+    {
+        class gpu_driven_scene
+        {
+        public:
+            gpu_driven_scene( ) = default;
+            gpu_driven_scene( const core::logical_device* p_logical_device, core::memory_allocator* p_memory_allocator,
+                              const core::pipeline_cache& pipeline_cache,
+                              core::upload_manager& upload_manager, const std::string& cull_shader_path,
+                              uint32_t max_object_count, PFN_vkCmdDrawIndexedIndirectCountKHR p_draw_indirect_count,
+                              bool has_multi_draw_indirect );
+            gpu_driven_scene( const gpu_driven_scene& gpu_driven_scene ) = delete;
+            gpu_driven_scene( gpu_driven_scene&& gpu_driven_scene ) noexcept;
+            ~gpu_driven_scene( ) = default;
+
+            /*
+             * The objects go into a fresh buffer and the current one is retired, so frames in flight
+             * keep culling and drawing the previous list. The buffer returned by get_object_buffer()
+             * changes, descriptor sets referring to it have to be rewritten.
+             */
+            core::upload_ticket set_objects( core::upload_manager& upload_manager, core::deletion_queue& deletion_queue,
+                                             const std::vector<object_data>& objects );
+
+            void record_culling( core::command_buffers& command_buffers, uint32_t index, const glm::mat4& view_projection );
+            void record_draw( core::command_buffers& command_buffers, uint32_t index );
+
+            VkBuffer& get_object_buffer()
+            {
+                return object_buffer_.get();
+            }
+
+            uint32_t get_object_count() const
+            {
+                return object_count_;
+            }
+
+            gpu_driven_scene& operator=( const gpu_driven_scene& gpu_driven_scene ) = delete;
+            gpu_driven_scene& operator=( gpu_driven_scene&& gpu_driven_scene ) noexcept;
+
+        private:
+            struct cull_constants
+            {
+                glm::vec4 frustum_planes[6];
+
+                uint32_t object_count;
+                uint32_t is_compacting;
+            };
+
+        private:
+            const core::logical_device* p_logical_device_ = nullptr;
+            core::memory_allocator* p_memory_allocator_ = nullptr;
+
+            compute::compute_kernel cull_kernel_;
+
+            core::buffer object_buffer_;
+            core::buffer draw_command_buffer_;
+            core::buffer draw_count_buffer_;
+
+            uint32_t max_object_count_ = 0;
+            uint32_t object_count_ = 0;
+
+            PFN_vkCmdDrawIndexedIndirectCountKHR p_draw_indirect_count_ = nullptr;
+            bool has_multi_draw_indirect_ = false;
+        };
+    }
+}
+
+#endif //PROJEKT_GPU_DRIVEN_SCENE_H
@@ -0,0 +1,222 @@
+/*!
+ *
+ */
+
+#include <algorithm>
+#include <limits>
+
+#include "gpu_profiler.h"
+
+namespace vk
+{
+    namespace graphics
+    {
+        constexpr const uint32_t INVALID_SCOPE = std::numeric_limits<uint32_t>::max();
+
+        gpu_profiler::scope::scope( gpu_profiler& profiler, core::command_buffers& command_buffers, const char* name, uint32_t index )
+            :
+            profiler_( profiler ),
+            command_buffers_( command_buffers ),
+            scope_( profiler.begin_scope( command_buffers, name, index ) ),
+            index_( index )
+        {
+        }
+        gpu_profiler::scope::~scope( )
+        {
+            profiler_.end_scope( command_buffers_, scope_, index_ );
+        }
+
+        gpu_profiler::gpu_profiler( const core::logical_device* p_logical_device, const core::physical_device& physical_device,
+                                    uint32_t frame_count, uint32_t max_scope_count )
+            :
+            max_scope_count_( max_scope_count )
+        {
+            auto valid_bits = physical_device.get_timestamp_valid_bits( helpers::queue_family_type::e_graphics );
+
+            timestamp_period_ = physical_device.get_properties().limits.timestampPeriod;
+            timestamp_mask_ = valid_bits >= 64 ? std::numeric_limits<uint64_t>::max() : ( uint64_t{ 1 } << valid_bits ) - 1;
+
+            /*
+             * Without timestamp support every call is a no-op and the timings stay empty.
+             */
+            is_supported_ = valid_bits > 0 && timestamp_period_ > 0.0;
+            if( !is_supported_ )
+                return;
+
+            query_pool_ = core::query_pool( p_logical_device, VK_QUERY_TYPE_TIMESTAMP, frame_count * max_scope_count_ * 2 );
+
+            frames_.resize( frame_count );
+            for( auto& frame : frames_ )
+                frame.names.reserve( max_scope_count_ );
+
+            results_.reserve( max_scope_count_ * 2 );
+            timings_.reserve( max_scope_count_ );
+        }
+        gpu_profiler::gpu_profiler( gpu_profiler&& gpu_profiler ) noexcept
+        {
+            *this = std::move( gpu_profiler );
+        }
+
+        void
+        gpu_profiler::begin_frame( core::command_buffers& command_buffers, uint32_t frame_index, uint32_t index )
+        {
+            if( !is_supported_ )
+                return;
+
+            resolve( frame_index );
+
+            current_frame_ = frame_index;
+            frames_[current_frame_].names.clear();
+            frames_[current_frame_].is_pending = false;
+
+            command_buffers.reset_query_pool( query_pool_.get(), current_frame_ * max_scope_count_ * 2, max_scope_count_ * 2, index );
+        }
+        void
+        gpu_profiler::end_frame( )
+        {
+            if( !is_supported_ )
+                return;
+
+            auto& frame = frames_[current_frame_];
+
+            frame.submit_time = std::chrono::steady_clock::now();
+            frame.is_pending = !frame.names.empty();
+        }
+
+        uint32_t
+        gpu_profiler::begin_scope( core::command_buffers& command_buffers, const char* name, uint32_t index )
+        {
+            if( !is_supported_ )
+                return INVALID_SCOPE;
+
+            auto& names = frames_[current_frame_].names;
+
+            if( names.size() >= max_scope_count_ )
+                return INVALID_SCOPE;
+
+            auto scope = static_cast<uint32_t>( names.size() );
+            names.push_back( name );
+
+            command_buffers.write_timestamp( VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, query_pool_.get(),
+                                             ( current_frame_ * max_scope_count_ + scope ) * 2, index );
+
+            return scope;
+        }
+        void
+        gpu_profiler::end_scope( core::command_buffers& command_buffers, uint32_t scope, uint32_t index )
+        {
+            if( scope == INVALID_SCOPE )
+                return;
+
+            command_buffers.write_timestamp( VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, query_pool_.get(),
+                                             ( current_frame_ * max_scope_count_ + scope ) * 2 + 1, index );
+        }
+
+        void
+        gpu_profiler::set_trace_writer( trace_writer* p_trace_writer )
+        {
+            p_trace_writer_ = p_trace_writer;
+
+            if( p_trace_writer_ )
+                p_trace_writer_->set_track_name( TRACK_ID, "GPU" );
+        }
+
+        void
+        gpu_profiler::resolve( uint32_t frame_index )
+        {
+            auto& frame = frames_[frame_index];
+
+            if( !frame.is_pending )
+                return;
+
+            frame.is_pending = false;
+
+            auto query_count = static_cast<uint32_t>( frame.names.size() ) * 2;
+
+            /*
+             * The frame context has been waited on, so the results should be there. If they
+             * aren't the frame is dropped rather than waited for.
+             */
+            if( !query_pool_.get_results( frame_index * max_scope_count_ * 2, query_count, results_ ) )
+                return;
+
+            for( auto& result : results_ )
+                result &= timestamp_mask_;
+
+            uint64_t origin = std::numeric_limits<uint64_t>::max();
+            uint64_t last = 0;
+            for( uint32_t i = 0; i < query_count; i += 2 )
+            {
+                origin = std::min( origin, results_[i] );
+                last = std::max( last, results_[i + 1] );
+            }
+
+            const double to_milliseconds = timestamp_period_ / 1000000.0;
+
+            timings_.clear();
+            for( size_t i = 0; i < frame.names.size(); ++i )
+            {
+                auto begin = results_[i * 2];
+                auto end = std::max( begin, results_[i * 2 + 1] );
+
+                gpu_timing timing = {};
+                timing.name = frame.names[i];
+                timing.start = static_cast<double>( begin - origin ) * to_milliseconds;
+                timing.duration = static_cast<double>( end - begin ) * to_milliseconds;
+
+                timings_.push_back( timing );
+            }
+
+            frame_time_ = last > origin ? static_cast<double>( last - origin ) * to_milliseconds : 0.0;
+
+            /*
+             * GPU and CPU clocks aren't calibrated against each other, so each frame is anchored
+             * at the moment it was submitted. Offsets within a frame are exact.
+             */
+            if( p_trace_writer_ && p_trace_writer_->is_capturing() )
+            {
+                auto submit_time = p_trace_writer_->to_microseconds( frame.submit_time );
+
+                for( const auto& timing : timings_ )
+                {
+                    trace_event event = {};
+                    event.name = timing.name;
+                    event.category = "gpu";
+                    event.track_id = TRACK_ID;
+                    event.start_us = submit_time + timing.start * 1000.0;
+                    event.duration_us = timing.duration * 1000.0;
+
+                    p_trace_writer_->add_event( std::move( event ) );
+                }
+            }
+        }
+
+        gpu_profiler&
+        gpu_profiler::operator=( gpu_profiler&& gpu_profiler ) noexcept
+        {
+            if( this != &gpu_profiler )
+            {
+                query_pool_ = std::move( gpu_profiler.query_pool_ );
+
+                frames_ = std::move( gpu_profiler.frames_ );
+                current_frame_ = gpu_profiler.current_frame_;
+                max_scope_count_ = gpu_profiler.max_scope_count_;
+
+                timestamp_mask_ = gpu_profiler.timestamp_mask_;
+                timestamp_period_ = gpu_profiler.timestamp_period_;
+
+                is_supported_ = gpu_profiler.is_supported_;
+                gpu_profiler.is_supported_ = false;
+
+                results_ = std::move( gpu_profiler.results_ );
+                timings_ = std::move( gpu_profiler.timings_ );
+                frame_time_ = gpu_profiler.frame_time_;
+
+                p_trace_writer_ = gpu_profiler.p_trace_writer_;
+                gpu_profiler.p_trace_writer_ = nullptr;
+            }
+
+            return *this;
+        }
+    }
+}
@@ -0,0 +1,143 @@
+/*!
+ * @brief Times GPU work with timestamp queries. Every frame context owns
+ * its own range of queries, which is read back when the context comes
+ * round again and has already been waited on, so reading never stalls.
+ * Timings lag the frame being recorded by frames in flight.
+ */
+
+#ifndef PROJEKT_GPU_PROFILER_H
+#define PROJEKT_GPU_PROFILER_H
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include <vulkan/vulkan.h>
+
+#include "../core/logical_device.h"
+#include "../core/physical_device.h"
+#include "../core/command_buffers.h"
+#include "../core/query_pool.h"
+#include "../../utils/profiling/trace_writer.h"
+
+namespace vk
+{
+    namespace graphics
+    {
+        struct gpu_timing
+        {
+            const char* name = "";
+
+            /*
+             * Both in milliseconds, start is relative to the first scope of the frame.
+             */
+            double start = 0.0;
+            double duration = 0.0;
+        };
+
+        class gpu_profiler
+        {
+        public:
+            /*
+             * Writes a timestamp pair around the commands recorded during its lifetime. Scopes
+             * can nest, but can't be opened inside a render pass recorded with secondary command buffers.
+             */
+            class scope
+            {
+            public:
+                scope( gpu_profiler& profiler, core::command_buffers& command_buffers, const char* name, uint32_t index );
+                scope( const scope& scope ) = delete;
+                ~scope( );
+
+                scope& operator=( const scope& scope ) = delete;
+
+            private:
+                gpu_profiler& profiler_;
+                core::command_buffers& command_buffers_;
+
+                uint32_t scope_;
+                uint32_t index_;
+            };
+
+        public:
+            static constexpr uint32_t TRACK_ID = 0;
+
+        public:
+            gpu_profiler( ) = default;
+            gpu_profiler( const core::logical_device* p_logical_device, const core::physical_device& physical_device,
+                          uint32_t frame_count, uint32_t max_scope_count = 32 );
+            gpu_profiler( const gpu_profiler& gpu_profiler ) = delete;
+            gpu_profiler( gpu_profiler&& gpu_profiler ) noexcept;
+            ~gpu_profiler( ) = default;
+
+            /*
+             * Collects the timings last written by frame frame_index, then resets its queries. Has to be
+             * recorded first, outside of any render pass, once the frame's previous submission has completed.
+             */
+            void begin_frame( core::command_buffers& command_buffers, uint32_t frame_index, uint32_t index );
+
+            /*
+             * Called once the frame has been submitted, its submit time places the GPU scopes in the trace.
+             */
+            void end_frame( );
+
+            uint32_t begin_scope( core::command_buffers& command_buffers, const char* name, uint32_t index );
+            void end_scope( core::command_buffers& command_buffers, uint32_t scope, uint32_t index );
+
+            /*
+             * Only valid for scopes that were begun, a scope left open reads as zero.
+             */
+            const std::vector<gpu_timing>& get_timings( ) const
+            {
+                return timings_;
+            }
+
+            /*
+             * From the start of the first scope to the end of the last one, in milliseconds.
+             */
+            double get_frame_time( ) const
+            {
+                return frame_time_;
+            }
+
+            bool is_supported( ) const
+            {
+                return is_supported_;
+            }
+
+            void set_trace_writer( trace_writer* p_trace_writer );
+
+            gpu_profiler& operator=( const gpu_profiler& gpu_profiler ) = delete;
+            gpu_profiler& operator=( gpu_profiler&& gpu_profiler ) noexcept;
+
+        private:
+            struct frame_queries
+            {
+                std::vector<const char*> names;
+                std::chrono::steady_clock::time_point submit_time;
+                bool is_pending = false;
+            };
+
+            void resolve( uint32_t frame_index );
+
+        private:
+            core::query_pool query_pool_;
+
+            std::vector<frame_queries> frames_;
+            uint32_t current_frame_ = 0;
+            uint32_t max_scope_count_ = 0;
+
+            uint64_t timestamp_mask_ = 0;
+            double timestamp_period_ = 0.0;
+            bool is_supported_ = false;
+
+            std::vector<uint64_t> results_;
+            std::vector<gpu_timing> timings_;
+            double frame_time_ = 0.0;
+
+            trace_writer* p_trace_writer_ = nullptr;
+        };
+    }
+}
+
+#endif //PROJEKT_GPU_PROFILER_H
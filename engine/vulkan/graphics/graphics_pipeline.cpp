@@ -3,18 +3,19 @@
  */
 
 #include "graphics_pipeline.h"
-#include "vertex.h"
 
 namespace vk
 {
     namespace graphics
     {
         graphics_pipeline::graphics_pipeline( const core::logical_device* p_logical_device,
+                                              const core::pipeline_cache& pipeline_cache,
                                               const core::render_pass& render_pass,
-                                              const swapchain& swapchain,
                                               const core::descriptor_set_layout& descriptor_set_layout,
                                               core::shader_module& vertex_shader,
-                                              core::shader_module& fragment_shader )
+                                              core::shader_module& fragment_shader,
+                                              const vertex_input_description& vertex_input,
+                                              const pipeline_state& state )
             :
             p_logical_device_( p_logical_device )
         {
@@ -23,61 +24,49 @@ namespace vk
 
             VkPipelineShaderStageCreateInfo shader_stages[] = { vert_shader_stage_info, frag_shader_stage_info };
 
-            auto binding_description = vertex::get_binding_description();
-            auto attribute_description = vertex::get_attribute_descriptions();
-
             VkPipelineVertexInputStateCreateInfo vertex_input_state_info = {};
             vertex_input_state_info.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
-            vertex_input_state_info.vertexBindingDescriptionCount = 1;
-            vertex_input_state_info.pVertexBindingDescriptions = &binding_description;
-            vertex_input_state_info.vertexAttributeDescriptionCount = static_cast<uint32_t>( attribute_description.size() );
-            vertex_input_state_info.pVertexAttributeDescriptions = attribute_description.data();
+            vertex_input_state_info.vertexBindingDescriptionCount = static_cast<uint32_t>( vertex_input.bindings.size() );
+            vertex_input_state_info.pVertexBindingDescriptions = vertex_input.bindings.data();
+            vertex_input_state_info.vertexAttributeDescriptionCount = static_cast<uint32_t>( vertex_input.attributes.size() );
+            vertex_input_state_info.pVertexAttributeDescriptions = vertex_input.attributes.data();
 
             VkPipelineInputAssemblyStateCreateInfo input_assembly_state_info = {};
             input_assembly_state_info.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
-            input_assembly_state_info.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+            input_assembly_state_info.topology = state.topology;
             input_assembly_state_info.primitiveRestartEnable = VK_FALSE;
 
-            VkViewport viewport = {};
-            viewport.x = 0.0f;
-            viewport.y = 0.0f;
-            viewport.width = static_cast<float>( swapchain.get_extent().width );
-            viewport.height = static_cast<float>( swapchain.get_extent().height );
-            viewport.minDepth = 0.0f;
-            viewport.maxDepth = 1.0f;
-
-            VkRect2D scissor = {};
-            scissor.offset = { 0, 0 };
-            scissor.extent = swapchain.get_extent();
-
+            /*
+             * Viewport and scissor are dynamic, leaving the pipeline independent of the swapchain extent.
+             */
             VkPipelineViewportStateCreateInfo viewport_state_info = {};
             viewport_state_info.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
             viewport_state_info.viewportCount = 1;
-            viewport_state_info.pViewports = &viewport;
+            viewport_state_info.pViewports = nullptr;
             viewport_state_info.scissorCount = 1;
-            viewport_state_info.pScissors = &scissor;
+            viewport_state_info.pScissors = nullptr;
 
             VkPipelineRasterizationStateCreateInfo rasterization_state_info = {};
             rasterization_state_info.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
             rasterization_state_info.depthClampEnable = VK_FALSE;
             rasterization_state_info.rasterizerDiscardEnable = VK_FALSE;
-            rasterization_state_info.polygonMode = VK_POLYGON_MODE_FILL;
+            rasterization_state_info.polygonMode = state.polygon_mode;
             rasterization_state_info.lineWidth = 1.0f;
-            rasterization_state_info.cullMode = VK_CULL_MODE_BACK_BIT;
-            rasterization_state_info.frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+            rasterization_state_info.cullMode = state.cull_mode;
+            rasterization_state_info.frontFace = state.front_face;
             rasterization_state_info.depthBiasEnable = VK_FALSE;
 
             VkPipelineMultisampleStateCreateInfo multisample_state_info = {};
             multisample_state_info.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
             multisample_state_info.sampleShadingEnable = VK_FALSE;
-            multisample_state_info.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+            multisample_state_info.rasterizationSamples = state.rasterization_samples;
 
             VkPipelineColorBlendAttachmentState colour_blend_attachment_state = {};
             colour_blend_attachment_state.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT |
                                                            VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
-            colour_blend_attachment_state.blendEnable = VK_FALSE;
-            colour_blend_attachment_state.srcColorBlendFactor = VK_BLEND_FACTOR_ONE;
-            colour_blend_attachment_state.dstColorBlendFactor = VK_BLEND_FACTOR_ZERO;
+            colour_blend_attachment_state.blendEnable = state.is_blending ? VK_TRUE : VK_FALSE;
+            colour_blend_attachment_state.srcColorBlendFactor = state.is_blending ? VK_BLEND_FACTOR_SRC_ALPHA : VK_BLEND_FACTOR_ONE;
+            colour_blend_attachment_state.dstColorBlendFactor = state.is_blending ? VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA : VK_BLEND_FACTOR_ZERO;
             colour_blend_attachment_state.colorBlendOp = VK_BLEND_OP_ADD;
             colour_blend_attachment_state.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
             colour_blend_attachment_state.dstAlphaBlendFactor = VK_BLEND_FACTOR_ZERO;
@@ -130,7 +119,7 @@ namespace vk
             create_info.renderPass = render_pass.get();
             create_info.subpass = 0;
 
-            pipeline_handle_ = p_logical_device_->create_graphics_pipeline( VK_NULL_HANDLE, create_info );
+            pipeline_handle_ = p_logical_device_->create_graphics_pipeline( pipeline_cache.get(), create_info );
         }
         graphics_pipeline::graphics_pipeline( graphics_pipeline&& graphics_pipeline ) noexcept
         {
@@ -5,8 +5,11 @@
 #ifndef PROJEKT_GRAPHICS_PIPELINE_H
 #define PROJEKT_GRAPHICS_PIPELINE_H
 
-#include "swapchain.h"
+#include "vertex.h"
+#include "vertex_input_description.h"
+#include "pipeline_state.h"
 #include "../core/logical_device.h"
+#include "../core/pipeline_cache.h"
 #include "../core/render_pass.h"
 #include "../core/shader_module.h"
 #include "../core/descriptor_set_layout.h"
@@ -19,10 +22,12 @@ namespace vk
         {
         public:
             graphics_pipeline( ) = default;
-            graphics_pipeline( const core::logical_device* p_logical_device,
-                               const core::render_pass& render_pass, const swapchain& swapchain,
+            graphics_pipeline( const core::logical_device* p_logical_device, const core::pipeline_cache& pipeline_cache,
+                               const core::render_pass& render_pass,
                                const core::descriptor_set_layout& descriptor_set_layout,
-                               core::shader_module& vertex_shader, core::shader_module& fragment_shader );
+                               core::shader_module& vertex_shader, core::shader_module& fragment_shader,
+                               const vertex_input_description& vertex_input = vertex::get_input_description(),
+                               const pipeline_state& state = { } );
             graphics_pipeline( const graphics_pipeline& graphics_pipeline ) = delete;
             graphics_pipeline( graphics_pipeline&& graphics_pipeline ) noexcept;
             ~graphics_pipeline( );
@@ -0,0 +1,81 @@
+/*!
+ *
+ */
+
+#ifndef PROJEKT_INSTANCE_DATA_H
+#define PROJEKT_INSTANCE_DATA_H
+
+#include <array>
+
+#include <vulkan/vulkan.h>
+#include <glm/glm.hpp>
+
+#include "vertex.h"
+#include "vertex_input_description.h"
+
+namespace vk
+{
+    namespace graphics
+    {
+        /*
+         * Per-instance attributes, streamed from binding 1 at VK_VERTEX_INPUT_RATE_INSTANCE.
+         * The transform takes one location per column.
+         */
+        struct instance_data
+        {
+            glm::mat4 transform;
+            glm::vec4 colour;
+
+            static VkVertexInputBindingDescription
+            get_binding_description()
+            {
+                VkVertexInputBindingDescription binding_description = {};
+                binding_description.binding = 1;
+                binding_description.stride = sizeof( instance_data );
+                binding_description.inputRate = VK_VERTEX_INPUT_RATE_INSTANCE;
+
+                return binding_description;
+            }
+
+            static std::array<VkVertexInputAttributeDescription, 5>
+            get_attribute_descriptions()
+            {
+                std::array<VkVertexInputAttributeDescription, 5> attribute_descriptions = {};
+
+                for( uint32_t i = 0; i < 4; ++i )
+                {
+                    attribute_descriptions[i].binding = 1;
+                    attribute_descriptions[i].location = 2 + i;
+                    attribute_descriptions[i].format = VK_FORMAT_R32G32B32A32_SFLOAT;
+                    attribute_descriptions[i].offset = static_cast<uint32_t>( offsetof( instance_data, transform ) + sizeof( glm::vec4 ) * i );
+                }
+
+                attribute_descriptions[4].binding = 1;
+                attribute_descriptions[4].location = 6;
+                attribute_descriptions[4].format = VK_FORMAT_R32G32B32A32_SFLOAT;
+                attribute_descriptions[4].offset = static_cast<uint32_t>( offsetof( instance_data, colour ) );
+
+                return attribute_descriptions;
+            }
+
+            /*
+             * The per-vertex stream at binding 0 followed by the per-instance stream at binding 1.
+             */
+            static vertex_input_description
+            get_input_description()
+            {
+                auto input_description = vertex::get_input_description();
+
+                auto attribute_descriptions = get_attribute_descriptions();
+
+                input_description.bindings.push_back( get_binding_description() );
+                input_description.attributes.insert( input_description.attributes.end(),
+                                                     attribute_descriptions.begin(), attribute_descriptions.end() );
+
+                return input_description;
+            }
+        };
+    }
+}
+
+#endif //PROJEKT_INSTANCE_DATA_H
@@ -0,0 +1,32 @@
+/*!
+ *
+ */
+
+#ifndef PROJEKT_OBJECT_DATA_H
+#define PROJEKT_OBJECT_DATA_H
+
+#include <glm/glm.hpp>
+
+namespace vk
+{
+    namespace graphics
+    {
+        /*
+         * Matches the std430 layout of the object buffer read by cull.comp and indirect.vert.
+         */
+        struct object_data
+        {
+            glm::mat4 model;
+
+            // xyz is the bounding sphere centre in model space, w its radius.
+            glm::vec4 bounding_sphere;
+
+            uint32_t index_count;
+            uint32_t first_index;
+            int32_t vertex_offset;
+            uint32_t padding;
+        };
+    }
+}
+
+#endif //PROJEKT_OBJECT_DATA_H
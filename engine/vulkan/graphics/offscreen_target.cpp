@@ -0,0 +1,168 @@
+/*!
+ *
+ */
+
+#include <cstring>
+
+#include "offscreen_target.h"
+
+namespace vk
+{
+    namespace graphics
+    {
+        offscreen_target::offscreen_target( const core::logical_device* p_logical_device, core::memory_allocator* p_memory_allocator,
+                                            uint32_t width, uint32_t height, uint32_t count, VkFormat format )
+            :
+            p_logical_device_( p_logical_device ),
+            p_memory_allocator_( p_memory_allocator ),
+            format_( format ),
+            extent_( { width, height } ),
+            count_( count )
+        {
+            VkImageCreateInfo create_info = {};
+            create_info.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+            create_info.imageType = VK_IMAGE_TYPE_2D;
+            create_info.extent.width = extent_.width;
+            create_info.extent.height = extent_.height;
+            create_info.extent.depth = 1;
+            create_info.mipLevels = 1;
+            create_info.arrayLayers = 1;
+            create_info.format = format_;
+            create_info.tiling = VK_IMAGE_TILING_OPTIMAL;
+            create_info.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+            create_info.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+            create_info.samples = VK_SAMPLE_COUNT_1_BIT;
+            create_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+            image_handles_.resize( count_ );
+            image_allocations_.resize( count_ );
+            for( uint32_t i = 0; i < count_; ++i )
+            {
+                image_handles_[i] = p_logical_device_->create_image( create_info );
+                image_allocations_[i] = p_memory_allocator_->allocate_image_memory( image_handles_[i], VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT );
+            }
+
+            VkImageViewCreateInfo image_view_create_info = {};
+            image_view_create_info.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+            image_view_create_info.viewType = VK_IMAGE_VIEW_TYPE_2D;
+            image_view_create_info.format = format_;
+            image_view_create_info.components.r = VK_COMPONENT_SWIZZLE_IDENTITY;
+            image_view_create_info.components.g = VK_COMPONENT_SWIZZLE_IDENTITY;
+            image_view_create_info.components.b = VK_COMPONENT_SWIZZLE_IDENTITY;
+            image_view_create_info.components.a = VK_COMPONENT_SWIZZLE_IDENTITY;
+            image_view_create_info.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            image_view_create_info.subresourceRange.baseMipLevel = 0;
+            image_view_create_info.subresourceRange.levelCount = 1;
+            image_view_create_info.subresourceRange.baseArrayLayer = 0;
+            image_view_create_info.subresourceRange.layerCount = 1;
+
+            image_view_handles_ = p_logical_device_->create_image_views( image_handles_.data(), image_view_create_info, count_ );
+
+            readback_buffer_ = core::buffer( p_logical_device_, p_memory_allocator_,
+                                             static_cast<VkDeviceSize>( extent_.width ) * extent_.height * 4,
+                                             VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                                             VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT );
+        }
+        offscreen_target::offscreen_target( offscreen_target&& offscreen_target ) noexcept
+        {
+            *this = std::move( offscreen_target );
+        }
+        offscreen_target::~offscreen_target( )
+        {
+            destroy( );
+        }
+
+        void
+        offscreen_target::record_readback( core::command_buffers& command_buffers, uint32_t image_index, uint32_t index )
+        {
+            /*
+             * The render pass already moved the image to TRANSFER_SRC_OPTIMAL, only the colour writes
+             * have to be made visible to the copy.
+             */
+            VkMemoryBarrier barrier = {};
+            barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+            barrier.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+            barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+
+            command_buffers.pipeline_barrier( VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                              1, &barrier, 0, nullptr, 0, nullptr, index );
+
+            VkBufferImageCopy region = {};
+            region.bufferOffset = 0;
+            region.bufferRowLength = 0;
+            region.bufferImageHeight = 0;
+            region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            region.imageSubresource.mipLevel = 0;
+            region.imageSubresource.baseArrayLayer = 0;
+            region.imageSubresource.layerCount = 1;
+            region.imageOffset = { 0, 0, 0 };
+            region.imageExtent = { extent_.width, extent_.height, 1 };
+
+            command_buffers.copy_image_to_buffer( image_handles_[image_index], VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                                                  readback_buffer_.get(), 1, &region, index );
+
+            barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            barrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+
+            command_buffers.pipeline_barrier( VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT,
+                                              1, &barrier, 0, nullptr, 0, nullptr, index );
+        }
+
+        void
+        offscreen_target::read_back( std::vector<uint8_t>& pixels ) const
+        {
+            pixels.resize( static_cast<size_t>( readback_buffer_.get_size() ) );
+
+            memcpy( pixels.data(), readback_buffer_.get_mapped_data(), pixels.size() );
+        }
+
+        offscreen_target&
+        offscreen_target::operator=( offscreen_target&& offscreen_target ) noexcept
+        {
+            if( this != &offscreen_target )
+            {
+                destroy( );
+
+                p_logical_device_ = offscreen_target.p_logical_device_;
+                p_memory_allocator_ = offscreen_target.p_memory_allocator_;
+
+                image_handles_ = std::move( offscreen_target.image_handles_ );
+                offscreen_target.image_handles_.clear();
+
+                image_allocations_ = std::move( offscreen_target.image_allocations_ );
+                offscreen_target.image_allocations_.clear();
+
+                image_view_handles_ = offscreen_target.image_view_handles_;
+                offscreen_target.image_view_handles_ = VK_NULL_HANDLE;
+
+                readback_buffer_ = std::move( offscreen_target.readback_buffer_ );
+
+                format_ = offscreen_target.format_;
+                extent_ = offscreen_target.extent_;
+
+                count_ = offscreen_target.count_;
+                offscreen_target.count_ = 0;
+            }
+
+            return *this;
+        }
+
+        void
+        offscreen_target::destroy( )
+        {
+            if( image_view_handles_ != VK_NULL_HANDLE )
+                image_view_handles_ = p_logical_device_->destroy_image_views( image_view_handles_, count_ );
+
+            for( auto& image_handle : image_handles_ )
+            {
+                if( image_handle != VK_NULL_HANDLE )
+                    image_handle = p_logical_device_->destroy_image( image_handle );
+            }
+            image_handles_.clear();
+
+            for( auto& allocation : image_allocations_ )
+                p_memory_allocator_->free( allocation );
+            image_allocations_.clear();
+        }
+    }
+}
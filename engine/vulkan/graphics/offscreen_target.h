@@ -0,0 +1,88 @@
+/*!
+ * @brief Colour images standing in for a swapchain when rendering without
+ * a surface. The render pass leaves them in TRANSFER_SRC_OPTIMAL so a
+ * frame can be copied into a host visible buffer and read back.
+ */
+
+#ifndef PROJEKT_OFFSCREEN_TARGET_H
+#define PROJEKT_OFFSCREEN_TARGET_H
+
+#include <cstdint>
+#include <vector>
+
+#include <vulkan/vulkan.h>
+
+#include "../core/logical_device.h"
+#include "../core/buffer.h"
+#include "../core/command_buffers.h"
+#include "../core/memory_allocator.h"
+
+namespace vk
+{
+    namespace graphics
+    {
+        class offscreen_target
+        {
+        public:
+            offscreen_target( ) = default;
+            offscreen_target( const core::logical_device* p_logical_device, core::memory_allocator* p_memory_allocator,
+                              uint32_t width, uint32_t height, uint32_t count, VkFormat format = VK_FORMAT_R8G8B8A8_UNORM );
+            offscreen_target( const offscreen_target& offscreen_target ) = delete;
+            offscreen_target( offscreen_target&& offscreen_target ) noexcept;
+            ~offscreen_target( );
+
+            /*
+             * Copies image image_index into the readback buffer. Must be recorded after the render pass
+             * that wrote the image has ended.
+             */
+            void record_readback( core::command_buffers& command_buffers, uint32_t image_index, uint32_t index );
+
+            /*
+             * Tightly packed rows of 4 byte texels, only valid once the recorded copy has completed.
+             */
+            void read_back( std::vector<uint8_t>& pixels ) const;
+
+            const VkImageView* get_image_views( ) const
+            {
+                return image_view_handles_;
+            }
+
+            uint32_t get_count( ) const
+            {
+                return count_;
+            }
+
+            const VkFormat& get_format( ) const
+            {
+                return format_;
+            }
+            const VkExtent2D& get_extent( ) const
+            {
+                return extent_;
+            }
+
+            offscreen_target& operator=( const offscreen_target& offscreen_target ) = delete;
+            offscreen_target& operator=( offscreen_target&& offscreen_target ) noexcept;
+
+        private:
+            void destroy( );
+
+        private:
+            const core::logical_device* p_logical_device_ = nullptr;
+            core::memory_allocator* p_memory_allocator_ = nullptr;
+
+            std::vector<VkImage> image_handles_;
+            std::vector<helpers::memory_allocation> image_allocations_;
+            VkImageView* image_view_handles_ = VK_NULL_HANDLE;
+
+            core::buffer readback_buffer_;
+
+            VkFormat format_ = VK_FORMAT_UNDEFINED;
+            VkExtent2D extent_ = { 0, 0 };
+
+            uint32_t count_ = 0;
+        };
+    }
+}
+
+#endif //PROJEKT_OFFSCREEN_TARGET_H
@@ -0,0 +1,214 @@
+/*!
+ *
+ */
+
+#include <algorithm>
+
+#include "parallel_recorder.h"
+#include "../../utils/profiling/cpu_profiler.h"
+
+namespace vk
+{
+    namespace graphics
+    {
+        parallel_recorder::parallel_recorder( const core::physical_device& physical_device, const core::logical_device* p_logical_device,
+                                              uint32_t frame_count, uint32_t worker_count )
+            :
+            job_( std::make_unique<job>() )
+        {
+            /*
+             * hardware_concurrency may report 0 when it can't tell, so clamp before leaving a core to the caller.
+             */
+            if( worker_count == 0 )
+            {
+                auto hardware_concurrency = std::thread::hardware_concurrency();
+                worker_count = hardware_concurrency > 1 ? hardware_concurrency - 1 : 1;
+            }
+
+            workers_.reserve( worker_count );
+            for( uint32_t i = 0; i < worker_count; ++i )
+            {
+                auto p_worker = std::make_unique<worker>();
+
+                p_worker->frame_command_pools.reserve( frame_count );
+                for( uint32_t frame = 0; frame < frame_count; ++frame )
+                    p_worker->frame_command_pools.emplace_back( physical_device, p_logical_device, helpers::queue_family_type::e_graphics );
+
+                workers_.emplace_back( std::move( p_worker ) );
+            }
+
+            for( uint32_t i = 0; i < worker_count; ++i )
+                workers_[i]->thread = std::thread( &parallel_recorder::work, job_.get(), workers_[i].get(), i, worker_count );
+
+            recorded_command_buffers_.reserve( worker_count );
+        }
+        parallel_recorder::parallel_recorder( parallel_recorder&& parallel_recorder ) noexcept
+        {
+            *this = std::move( parallel_recorder );
+        }
+        parallel_recorder::~parallel_recorder( )
+        {
+            shutdown( );
+        }
+
+        const std::vector<VkCommandBuffer>&
+        parallel_recorder::record( uint32_t frame_index, const VkCommandBufferInheritanceInfo& inheritance_info,
+                                   size_t draw_count, const record_function& function )
+        {
+            recorded_command_buffers_.clear();
+
+            if( draw_count == 0 )
+                return recorded_command_buffers_;
+
+            {
+                std::lock_guard<std::mutex> lock( job_->mutex );
+
+                job_->frame_index = frame_index;
+                job_->inheritance_info = inheritance_info;
+                job_->draw_count = draw_count;
+                job_->p_function = &function;
+                job_->error = nullptr;
+
+                job_->pending = static_cast<uint32_t>( workers_.size() );
+                ++job_->generation;
+            }
+
+            job_->work_condition.notify_all();
+
+            {
+                std::unique_lock<std::mutex> lock( job_->mutex );
+                job_->done_condition.wait( lock, [this]{ return job_->pending == 0; } );
+
+                if( job_->error )
+                    std::rethrow_exception( job_->error );
+            }
+
+            /*
+             * Keeping the worker order keeps the draw order of the list intact.
+             */
+            for( auto& p_worker : workers_ )
+            {
+                if( p_worker->p_recorded != nullptr )
+                    recorded_command_buffers_.push_back( ( *p_worker->p_recorded )[0] );
+            }
+
+            return recorded_command_buffers_;
+        }
+
+        parallel_recorder&
+        parallel_recorder::operator=( parallel_recorder&& parallel_recorder ) noexcept
+        {
+            if( this != &parallel_recorder )
+            {
+                shutdown( );
+
+                job_ = std::move( parallel_recorder.job_ );
+                workers_ = std::move( parallel_recorder.workers_ );
+                recorded_command_buffers_ = std::move( parallel_recorder.recorded_command_buffers_ );
+            }
+
+            return *this;
+        }
+
+        void
+        parallel_recorder::work( job* p_job, worker* p_worker, uint32_t worker_index, uint32_t worker_count )
+        {
+            cpu_profiler::set_thread_name( "recorder " + std::to_string( worker_index ) );
+
+            uint64_t generation = 0;
+
+            while( true )
+            {
+                uint32_t frame_index;
+                VkCommandBufferInheritanceInfo inheritance_info;
+                size_t draw_count;
+                const record_function* p_function;
+
+                {
+                    std::unique_lock<std::mutex> lock( p_job->mutex );
+                    p_job->work_condition.wait( lock, [p_job, generation]{ return p_job->should_stop || p_job->generation != generation; } );
+
+                    if( p_job->should_stop )
+                        return;
+
+                    generation = p_job->generation;
+
+                    frame_index = p_job->frame_index;
+                    inheritance_info = p_job->inheritance_info;
+                    draw_count = p_job->draw_count;
+                    p_function = p_job->p_function;
+                }
+
+                auto slice_size = ( draw_count + worker_count - 1 ) / worker_count;
+                auto first = std::min( draw_count, worker_index * slice_size );
+                auto last = std::min( draw_count, first + slice_size );
+
+                p_worker->p_recorded = nullptr;
+
+                std::exception_ptr error;
+                try
+                {
+                    cpu_profiler::zone zone( "record slice" );
+
+                    /*
+                     * The frame's fence has been waited on before recording starts, so
+                     * everything allocated from this pool is free to be recycled.
+                     */
+                    auto& frame_command_pool = p_worker->frame_command_pools[frame_index];
+                    frame_command_pool.reset( );
+
+                    if( first < last )
+                    {
+                        auto& command_buffer = frame_command_pool.acquire( VK_COMMAND_BUFFER_LEVEL_SECONDARY );
+
+                        command_buffer.begin( VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT,
+                                              inheritance_info, 0 );
+
+                        ( *p_function )( command_buffer, 0, first, last );
+
+                        command_buffer.end( 0 );
+
+                        p_worker->p_recorded = &command_buffer;
+                    }
+                }
+                catch( ... )
+                {
+                    error = std::current_exception();
+                }
+
+                {
+                    std::lock_guard<std::mutex> lock( p_job->mutex );
+
+                    if( error && !p_job->error )
+                        p_job->error = error;
+
+                    if( --p_job->pending == 0 )
+                        p_job->done_condition.notify_one();
+                }
+            }
+        }
+
+        void
+        parallel_recorder::shutdown( )
+        {
+            if( !job_ )
+                return;
+
+            {
+                std::lock_guard<std::mutex> lock( job_->mutex );
+                job_->should_stop = true;
+            }
+
+            job_->work_condition.notify_all();
+
+            for( auto& p_worker : workers_ )
+            {
+                if( p_worker->thread.joinable() )
+                    p_worker->thread.join();
+            }
+
+            workers_.clear();
+            job_.reset();
+        }
+    }
+}
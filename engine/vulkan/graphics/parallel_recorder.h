@@ -0,0 +1,95 @@
+/*!
+ * @brief Records secondary command buffers on a set of worker threads.
+ * Every worker owns a transient command pool per frame in flight and
+ * records one slice of the draw list per frame.
+ */
+
+#ifndef PROJEKT_PARALLEL_RECORDER_H
+#define PROJEKT_PARALLEL_RECORDER_H
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <vulkan/vulkan.h>
+
+#include "../core/physical_device.h"
+#include "../core/logical_device.h"
+#include "../core/command_buffers.h"
+#include "../core/frame_command_pool.h"
+
+namespace vk
+{
+    namespace graphics
+    {
+        class parallel_recorder
+        {
+        public:
+            using record_function = std::function<void( core::command_buffers& command_buffers, uint32_t index,
+                                                        size_t first, size_t last )>;
+
+        public:
+            parallel_recorder( ) = default;
+            parallel_recorder( const core::physical_device& physical_device, const core::logical_device* p_logical_device,
+                               uint32_t frame_count, uint32_t worker_count = 0 );
+            parallel_recorder( const parallel_recorder& parallel_recorder ) = delete;
+            parallel_recorder( parallel_recorder&& parallel_recorder ) noexcept;
+            ~parallel_recorder( );
+
+            const std::vector<VkCommandBuffer>& record( uint32_t frame_index, const VkCommandBufferInheritanceInfo& inheritance_info,
+                                                        size_t draw_count, const record_function& function );
+
+            uint32_t get_worker_count() const
+            {
+                return static_cast<uint32_t>( workers_.size() );
+            }
+
+            parallel_recorder& operator=( const parallel_recorder& parallel_recorder ) = delete;
+            parallel_recorder& operator=( parallel_recorder&& parallel_recorder ) noexcept;
+
+        private:
+            struct job
+            {
+                std::mutex mutex;
+                std::condition_variable work_condition;
+                std::condition_variable done_condition;
+
+                uint64_t generation = 0;
+                uint32_t pending = 0;
+                bool should_stop = false;
+
+                uint32_t frame_index = 0;
+                VkCommandBufferInheritanceInfo inheritance_info = {};
+                size_t draw_count = 0;
+                const record_function* p_function = nullptr;
+
+                std::exception_ptr error;
+            };
+
+            struct worker
+            {
+                std::vector<core::frame_command_pool> frame_command_pools;
+
+                std::thread thread;
+
+                core::command_buffers* p_recorded = nullptr;
+            };
+
+            static void work( job* p_job, worker* p_worker, uint32_t worker_index, uint32_t worker_count );
+
+            void shutdown( );
+
+        private:
+            std::unique_ptr<job> job_;
+            std::vector<std::unique_ptr<worker>> workers_;
+
+            std::vector<VkCommandBuffer> recorded_command_buffers_;
+        };
+    }
+}
+
+#endif //PROJEKT_PARALLEL_RECORDER_H
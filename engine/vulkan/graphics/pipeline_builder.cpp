@@ -0,0 +1,345 @@
+/*!
+ *
+ */
+
+#include <iostream>
+
+#include "pipeline_builder.h"
+#include "../../utils/exception/vulkan_exception.h"
+#include "../../utils/file_io/read.h"
+#include "../../utils/profiling/cpu_profiler.h"
+
+namespace vk
+{
+    namespace graphics
+    {
+        pipeline_builder::pipeline_builder( const core::logical_device* p_logical_device, const core::pipeline_cache& pipeline_cache,
+                                            const core::render_pass& render_pass, uint32_t worker_count )
+            :
+            state_( std::make_unique<shared_state>() )
+        {
+            state_->p_logical_device = p_logical_device;
+            state_->p_pipeline_cache = &pipeline_cache;
+            state_->p_render_pass = &render_pass;
+
+            /*
+             * hardware_concurrency may report 0 when it can't tell, so clamp before leaving a core to the caller.
+             */
+            if( worker_count == 0 )
+            {
+                auto hardware_concurrency = std::thread::hardware_concurrency();
+                worker_count = hardware_concurrency > 1 ? hardware_concurrency - 1 : 1;
+            }
+
+            workers_.reserve( worker_count );
+            for( uint32_t i = 0; i < worker_count; ++i )
+                workers_.emplace_back( &pipeline_builder::work, state_.get() );
+        }
+        pipeline_builder::pipeline_builder( pipeline_builder&& pipeline_builder ) noexcept
+        {
+            *this = std::move( pipeline_builder );
+        }
+        pipeline_builder::~pipeline_builder( )
+        {
+            shutdown( );
+        }
+
+        pipeline_builder::pipeline_id
+        pipeline_builder::submit( const pipeline_description& description )
+        {
+            if( description.p_descriptor_set_layout == nullptr )
+                throw vulkan_exception{ "A pipeline description needs a descriptor set layout.", __FILE__, __LINE__ };
+
+            if( description.state.polygon_mode != VK_POLYGON_MODE_FILL &&
+                state_->p_logical_device->get_enabled_features().fillModeNonSolid != VK_TRUE )
+            {
+                throw vulkan_exception{ "Polygon modes other than fill need the fillModeNonSolid feature.", __FILE__, __LINE__ };
+            }
+
+            if( description.state.rasterization_samples != state_->p_render_pass->get_samples() )
+                throw vulkan_exception{ "The sample count of a pipeline must match its render pass.", __FILE__, __LINE__ };
+
+            auto vertex_shader_code = read_from_binary_file( description.vertex_shader_path );
+            auto fragment_shader_code = read_from_binary_file( description.fragment_shader_path );
+
+            auto key = make_key( description, vertex_shader_code, fragment_shader_code );
+
+            pipeline_id id;
+            {
+                std::lock_guard<std::mutex> lock( state_->mutex );
+
+                auto it = state_->ids.find( key );
+                if( it != state_->ids.end() )
+                {
+                    ++state_->slots[it->second]->reference_count;
+
+                    return it->second;
+                }
+
+                auto p_slot = std::make_unique<slot>();
+                p_slot->description = description;
+                p_slot->vertex_shader_code = std::move( vertex_shader_code );
+                p_slot->fragment_shader_code = std::move( fragment_shader_code );
+                p_slot->reference_count = 1;
+
+                id = static_cast<pipeline_id>( state_->slots.size() );
+
+                state_->slots.emplace_back( std::move( p_slot ) );
+                state_->queue.push_back( id );
+                state_->ids.emplace( std::move( key ), id );
+            }
+
+            state_->work_condition.notify_one();
+
+            return id;
+        }
+        std::vector<pipeline_builder::pipeline_id>
+        pipeline_builder::submit( const std::vector<pipeline_description>& descriptions )
+        {
+            std::vector<pipeline_id> ids;
+            ids.reserve( descriptions.size() );
+
+            for( const auto& description : descriptions )
+                ids.push_back( submit( description ) );
+
+            return ids;
+        }
+
+        graphics_pipeline*
+        pipeline_builder::try_get( pipeline_id id )
+        {
+            std::lock_guard<std::mutex> lock( state_->mutex );
+
+            auto& p_slot = state_->slots.at( id );
+
+            if( p_slot->state == status::e_failed && !p_slot->is_error_reported )
+            {
+                p_slot->is_error_reported = true;
+
+                try
+                {
+                    std::rethrow_exception( p_slot->error );
+                }
+                catch( const std::exception& e )
+                {
+                    std::cerr << "Pipeline " << id << " failed to build: " << e.what() << std::endl;
+                }
+                catch( ... )
+                {
+                    std::cerr << "Pipeline " << id << " failed to build." << std::endl;
+                }
+            }
+
+            return p_slot->state == status::e_ready ? &p_slot->pipeline : nullptr;
+        }
+
+        void
+        pipeline_builder::release( pipeline_id id, core::deletion_queue& deletion_queue )
+        {
+            std::unique_lock<std::mutex> lock( state_->mutex );
+
+            auto* p_slot = state_->slots.at( id ).get();
+
+            if( p_slot->state == status::e_released || --p_slot->reference_count > 0 )
+                return;
+
+            /*
+             * A worker may still be building it, the slot is only touched once it is done.
+             */
+            state_->done_condition.wait( lock, [p_slot]{ return p_slot->state != status::e_pending; } );
+
+            for( auto it = state_->ids.begin(); it != state_->ids.end(); ++it )
+            {
+                if( it->second == id )
+                {
+                    state_->ids.erase( it );
+                    break;
+                }
+            }
+
+            deletion_queue.retire( std::move( p_slot->pipeline ) );
+            deletion_queue.retire( std::move( p_slot->vertex_shader ) );
+            deletion_queue.retire( std::move( p_slot->fragment_shader ) );
+
+            p_slot->vertex_shader_code = std::string();
+            p_slot->fragment_shader_code = std::string();
+            p_slot->error = nullptr;
+            p_slot->state = status::e_released;
+        }
+
+        void
+        pipeline_builder::rebuild_all( )
+        {
+            wait_idle( );
+
+            {
+                std::lock_guard<std::mutex> lock( state_->mutex );
+
+                state_->ids.clear();
+
+                for( pipeline_id id = 0; id < state_->slots.size(); ++id )
+                {
+                    auto& p_slot = state_->slots[id];
+
+                    if( p_slot->state == status::e_released )
+                        continue;
+
+                    p_slot->state = status::e_pending;
+                    p_slot->error = nullptr;
+                    p_slot->is_error_reported = false;
+
+                    state_->ids.emplace( make_key( p_slot->description, p_slot->vertex_shader_code, p_slot->fragment_shader_code ), id );
+                    state_->queue.push_back( id );
+                }
+            }
+
+            state_->work_condition.notify_all();
+        }
+
+        void
+        pipeline_builder::wait( pipeline_id id )
+        {
+            std::unique_lock<std::mutex> lock( state_->mutex );
+
+            auto* p_slot = state_->slots.at( id ).get();
+            state_->done_condition.wait( lock, [p_slot]{ return p_slot->state != status::e_pending; } );
+
+            if( p_slot->state == status::e_failed )
+                std::rethrow_exception( p_slot->error );
+
+            if( p_slot->state == status::e_released )
+                throw vulkan_exception{ "Waiting on a pipeline that has been released.", __FILE__, __LINE__ };
+        }
+        void
+        pipeline_builder::wait_idle( )
+        {
+            if( !state_ )
+                return;
+
+            std::unique_lock<std::mutex> lock( state_->mutex );
+            state_->done_condition.wait( lock, [this]{ return state_->queue.empty() && state_->in_progress == 0; } );
+        }
+
+        uint32_t
+        pipeline_builder::get_pipeline_count( ) const
+        {
+            std::lock_guard<std::mutex> lock( state_->mutex );
+
+            return static_cast<uint32_t>( state_->slots.size() );
+        }
+
+        pipeline_builder&
+        pipeline_builder::operator=( pipeline_builder&& pipeline_builder ) noexcept
+        {
+            if( this != &pipeline_builder )
+            {
+                shutdown( );
+
+                state_ = std::move( pipeline_builder.state_ );
+                workers_ = std::move( pipeline_builder.workers_ );
+            }
+
+            return *this;
+        }
+
+        void
+        pipeline_builder::work( shared_state* p_state )
+        {
+            cpu_profiler::set_thread_name( "pipeline builder" );
+
+            while( true )
+            {
+                slot* p_slot;
+
+                {
+                    std::unique_lock<std::mutex> lock( p_state->mutex );
+                    p_state->work_condition.wait( lock, [p_state]{ return p_state->should_stop || !p_state->queue.empty(); } );
+
+                    if( p_state->should_stop )
+                        return;
+
+                    p_slot = p_state->slots[p_state->queue.front()].get();
+                    p_state->queue.pop_front();
+
+                    ++p_state->in_progress;
+                }
+
+                /*
+                 * Pipeline creation against a shared VkPipelineCache is internally synchronised
+                 * by the driver, so the slot is the only state touched outside of the lock.
+                 */
+                std::exception_ptr error;
+                try
+                {
+                    cpu_profiler::zone zone( "build pipeline" );
+
+                    const auto& description = p_slot->description;
+
+                    p_slot->vertex_shader = core::shader_module( p_state->p_logical_device, p_slot->vertex_shader_code.data(),
+                                                                 p_slot->vertex_shader_code.size() );
+                    p_slot->fragment_shader = core::shader_module( p_state->p_logical_device, p_slot->fragment_shader_code.data(),
+                                                                   p_slot->fragment_shader_code.size() );
+
+                    p_slot->pipeline = graphics_pipeline( p_state->p_logical_device, *p_state->p_pipeline_cache,
+                                                          *p_state->p_render_pass,
+                                                          *description.p_descriptor_set_layout,
+                                                          p_slot->vertex_shader, p_slot->fragment_shader,
+                                                          description.vertex_input, description.state );
+                }
+                catch( ... )
+                {
+                    error = std::current_exception();
+                }
+
+                {
+                    std::lock_guard<std::mutex> lock( p_state->mutex );
+
+                    p_slot->state = error ? status::e_failed : status::e_ready;
+                    p_slot->error = error;
+
+                    --p_state->in_progress;
+                }
+
+                p_state->done_condition.notify_all();
+            }
+        }
+
+        pipeline_key
+        pipeline_builder::make_key( const pipeline_description& description, const std::string& vertex_shader_code,
+                                    const std::string& fragment_shader_code ) const
+        {
+            pipeline_key key = {};
+            key.vertex_shader_code = vertex_shader_code;
+            key.fragment_shader_code = fragment_shader_code;
+            key.descriptor_set_layout = description.p_descriptor_set_layout->get();
+            key.colour_format = state_->p_render_pass->get_format();
+            key.vertex_input = description.vertex_input;
+            key.state = description.state;
+
+            return key;
+        }
+
+        void
+        pipeline_builder::shutdown( )
+        {
+            if( !state_ )
+                return;
+
+            {
+                std::lock_guard<std::mutex> lock( state_->mutex );
+                state_->should_stop = true;
+            }
+
+            state_->work_condition.notify_all();
+
+            for( auto& worker : workers_ )
+            {
+                if( worker.joinable() )
+                    worker.join();
+            }
+
+            workers_.clear();
+            state_.reset();
+        }
+    }
+}
@@ -0,0 +1,156 @@
+/*!
+ * @brief Compiles graphics pipelines on a set of worker threads against a
+ * shared pipeline cache. Submitting a description returns an id straight
+ * away, the pipeline behind it becomes available once its worker is done.
+ */
+
+#ifndef PROJEKT_PIPELINE_BUILDER_H
+#define PROJEKT_PIPELINE_BUILDER_H
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <vulkan/vulkan.h>
+
+#include "graphics_pipeline.h"
+#include "pipeline_key.h"
+#include "pipeline_state.h"
+#include "vertex.h"
+#include "vertex_input_description.h"
+#include "../core/logical_device.h"
+#include "../core/pipeline_cache.h"
+#include "../core/render_pass.h"
+#include "../core/deletion_queue.h"
+#include "../core/descriptor_set_layout.h"
+#include "../core/shader_module.h"
+
+namespace vk
+{
+    namespace graphics
+    {
+        struct pipeline_description
+        {
+            std::string vertex_shader_path;
+            std::string fragment_shader_path;
+
+            const core::descriptor_set_layout* p_descriptor_set_layout = nullptr;
+
+            vertex_input_description vertex_input = vertex::get_input_description();
+            pipeline_state state;
+        };
+
+        class pipeline_builder
+        {
+        public:
+            using pipeline_id = uint32_t;
+
+        public:
+            pipeline_builder( ) = default;
+            pipeline_builder( const core::logical_device* p_logical_device, const core::pipeline_cache& pipeline_cache,
+                              const core::render_pass& render_pass, uint32_t worker_count = 0 );
+            pipeline_builder( const pipeline_builder& pipeline_builder ) = delete;
+            pipeline_builder( pipeline_builder&& pipeline_builder ) noexcept;
+            ~pipeline_builder( );
+
+            /*
+             * The shaders are read on the calling thread. A description matching one already
+             * submitted, shader contents included, returns the existing id instead of compiling
+             * a duplicate. Every submit holds a reference on the id until it is released.
+             */
+            pipeline_id submit( const pipeline_description& description );
+            std::vector<pipeline_id> submit( const std::vector<pipeline_description>& descriptions );
+
+            /*
+             * Returns nullptr while the pipeline is still compiling or if it failed to, so it
+             * is safe to call every frame. A failure is reported once, wait rethrows it.
+             */
+            graphics_pipeline* try_get( pipeline_id id );
+
+            /*
+             * Drops one reference on id. Once none are left the pipeline and its shader modules are
+             * handed to deletion_queue, as frames in flight may still be using them, and the id
+             * is never returned again.
+             */
+            void release( pipeline_id id, core::deletion_queue& deletion_queue );
+
+            /*
+             * Recompiles every pipeline against the current render pass, used when its format changed.
+             * The caller must make sure none of the old pipelines are still in use by the device.
+             */
+            void rebuild_all( );
+
+            void wait( pipeline_id id );
+            void wait_idle( );
+
+            uint32_t get_pipeline_count( ) const;
+
+            pipeline_builder& operator=( const pipeline_builder& pipeline_builder ) = delete;
+            pipeline_builder& operator=( pipeline_builder&& pipeline_builder ) noexcept;
+
+        private:
+            enum class status
+            {
+                e_pending,
+                e_ready,
+                e_failed,
+                e_released
+            };
+
+            struct slot
+            {
+                pipeline_description description;
+                std::string vertex_shader_code;
+                std::string fragment_shader_code;
+
+                core::shader_module vertex_shader;
+                core::shader_module fragment_shader;
+                graphics_pipeline pipeline;
+
+                status state = status::e_pending;
+                std::exception_ptr error;
+                bool is_error_reported = false;
+
+                uint32_t reference_count = 0;
+            };
+
+            struct shared_state
+            {
+                std::mutex mutex;
+                std::condition_variable work_condition;
+                std::condition_variable done_condition;
+
+                std::deque<std::unique_ptr<slot>> slots;
+                std::deque<pipeline_id> queue;
+
+                std::unordered_map<pipeline_key, pipeline_id, pipeline_key_hash> ids;
+
+                uint32_t in_progress = 0;
+                bool should_stop = false;
+
+                const core::logical_device* p_logical_device = nullptr;
+                const core::pipeline_cache* p_pipeline_cache = nullptr;
+                const core::render_pass* p_render_pass = nullptr;
+            };
+
+            static void work( shared_state* p_state );
+
+            pipeline_key make_key( const pipeline_description& description, const std::string& vertex_shader_code,
+                                   const std::string& fragment_shader_code ) const;
+
+            void shutdown( );
+
+        private:
+            std::unique_ptr<shared_state> state_;
+            std::vector<std::thread> workers_;
+        };
+    }
+}
+
+#endif //PROJEKT_PIPELINE_BUILDER_H
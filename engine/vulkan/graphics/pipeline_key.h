@@ -0,0 +1,111 @@
+/*!
+ * @brief Identifies a graphics pipeline by everything that goes into
+ * building it, so identical requests can share one VkPipeline. Shaders
+ * are keyed on their SPIR-V rather than their path, so a module edited in
+ * place gets a new pipeline and one module reached through two paths
+ * shares one.
+ */
+
+#ifndef PROJEKT_PIPELINE_KEY_H
+#define PROJEKT_PIPELINE_KEY_H
+
+#include <string>
+
+#include <vulkan/vulkan.h>
+
+#include "pipeline_state.h"
+#include "vertex_input_description.h"
+#include "../helpers/hash.h"
+
+namespace vk
+{
+    namespace graphics
+    {
+        struct pipeline_key
+        {
+            std::string vertex_shader_code;
+            std::string fragment_shader_code;
+
+            VkDescriptorSetLayout descriptor_set_layout = VK_NULL_HANDLE;
+
+            // Render passes with the same attachment format are compatible.
+            VkFormat colour_format = VK_FORMAT_UNDEFINED;
+
+            vertex_input_description vertex_input;
+            pipeline_state state;
+
+            bool operator==( const pipeline_key& other ) const
+            {
+                if( vertex_shader_code != other.vertex_shader_code ||
+                    fragment_shader_code != other.fragment_shader_code ||
+                    descriptor_set_layout != other.descriptor_set_layout ||
+                    colour_format != other.colour_format ||
+                    !( state == other.state ) ||
+                    vertex_input.bindings.size() != other.vertex_input.bindings.size() ||
+                    vertex_input.attributes.size() != other.vertex_input.attributes.size() )
+                {
+                    return false;
+                }
+
+                for( size_t i = 0; i < vertex_input.bindings.size(); ++i )
+                {
+                    const auto& lhs = vertex_input.bindings[i];
+                    const auto& rhs = other.vertex_input.bindings[i];
+
+                    if( lhs.binding != rhs.binding || lhs.stride != rhs.stride || lhs.inputRate != rhs.inputRate )
+                        return false;
+                }
+
+                for( size_t i = 0; i < vertex_input.attributes.size(); ++i )
+                {
+                    const auto& lhs = vertex_input.attributes[i];
+                    const auto& rhs = other.vertex_input.attributes[i];
+
+                    if( lhs.location != rhs.location || lhs.binding != rhs.binding || lhs.format != rhs.format || lhs.offset != rhs.offset )
+                        return false;
+                }
+
+                return true;
+            }
+        };
+
+        struct pipeline_key_hash
+        {
+            std::size_t operator()( const pipeline_key& key ) const
+            {
+                std::size_t seed = 0;
+
+                helpers::hash_combine( seed, key.vertex_shader_code );
+                helpers::hash_combine( seed, key.fragment_shader_code );
+                helpers::hash_combine( seed, reinterpret_cast<uintptr_t>( key.descriptor_set_layout ) );
+                helpers::hash_combine( seed, static_cast<uint32_t>( key.colour_format ) );
+
+                for( const auto& binding : key.vertex_input.bindings )
+                {
+                    helpers::hash_combine( seed, binding.binding );
+                    helpers::hash_combine( seed, binding.stride );
+                    helpers::hash_combine( seed, static_cast<uint32_t>( binding.inputRate ) );
+                }
+
+                for( const auto& attribute : key.vertex_input.attributes )
+                {
+                    helpers::hash_combine( seed, attribute.location );
+                    helpers::hash_combine( seed, attribute.binding );
+                    helpers::hash_combine( seed, static_cast<uint32_t>( attribute.format ) );
+                    helpers::hash_combine( seed, attribute.offset );
+                }
+
+                helpers::hash_combine( seed, static_cast<uint32_t>( key.state.topology ) );
+                helpers::hash_combine( seed, static_cast<uint32_t>( key.state.polygon_mode ) );
+                helpers::hash_combine( seed, static_cast<uint32_t>( key.state.cull_mode ) );
+                helpers::hash_combine( seed, static_cast<uint32_t>( key.state.front_face ) );
+                helpers::hash_combine( seed, static_cast<uint32_t>( key.state.rasterization_samples ) );
+                helpers::hash_combine( seed, key.state.is_blending );
+
+                return seed;
+            }
+        };
+    }
+}
+
+#endif //PROJEKT_PIPELINE_KEY_H
@@ -0,0 +1,52 @@
+/*!
+ *
+ */
+
+#ifndef PROJEKT_PIPELINE_STATE_H
+#define PROJEKT_PIPELINE_STATE_H
+
+#include <vulkan/vulkan.h>
+
+namespace vk
+{
+    namespace graphics
+    {
+        /*
+         * The fixed-function state a pipeline can vary in. Viewport and scissor are
+         * always dynamic so they never take part in it.
+         */
+        struct pipeline_state
+        {
+            VkPrimitiveTopology topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+
+            /*
+             * Anything but fill needs the fillModeNonSolid feature.
+             */
+            VkPolygonMode polygon_mode = VK_POLYGON_MODE_FILL;
+            VkCullModeFlags cull_mode = VK_CULL_MODE_BACK_BIT;
+            VkFrontFace front_face = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+
+            /*
+             * Must match the sample count of the render pass the pipeline is built against.
+             */
+            VkSampleCountFlagBits rasterization_samples = VK_SAMPLE_COUNT_1_BIT;
+
+            /*
+             * Standard src_alpha, one_minus_src_alpha blending when enabled.
+             */
+            bool is_blending = false;
+
+            bool operator==( const pipeline_state& other ) const
+            {
+                return topology == other.topology &&
+                       polygon_mode == other.polygon_mode &&
+                       cull_mode == other.cull_mode &&
+                       front_face == other.front_face &&
+                       rasterization_samples == other.rasterization_samples &&
+                       is_blending == other.is_blending;
+            }
+        };
+    }
+}
+
+#endif //PROJEKT_PIPELINE_STATE_H
@@ -6,28 +6,24 @@
 #undef min
 #undef max
 #include <algorithm>
+#include <limits>
 
 namespace vk
 {
     namespace graphics
     {
         swapchain::swapchain( const core::logical_device* p_logical_device, const core::physical_device& physical_device,
-                              const surface& surface, uint32_t width, uint32_t height, VkSwapchainKHR old_swapchain_handle )
+                              const surface& surface, uint32_t width, uint32_t height, VkSwapchainKHR old_swapchain_handle,
+                              const swapchain_settings& settings )
             :
             p_logical_device_( p_logical_device )
         {
             auto support_details = physical_device.query_swapchain_support( surface );
 
             auto surface_format = choose_surface_format( support_details.formats );
-            auto present_mode = choose_present_mode( support_details.present_modes );
+            auto present_mode = choose_present_mode( support_details.present_modes, settings.policy );
             auto extent = choose_extent_2d( support_details.capabilities, width, height );
-
-            uint32_t image_count = support_details.capabilities.minImageCount + 1;
-            if( support_details.capabilities.maxImageCount > 0 &&
-                image_count > support_details.capabilities.maxImageCount )
-            {
-                image_count = support_details.capabilities.maxImageCount;
-            }
+            auto image_count = choose_image_count( support_details.capabilities, settings.image_count );
 
             VkSwapchainCreateInfoKHR create_info = {};
             create_info.sType = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR;
@@ -67,6 +63,7 @@ namespace vk
 
             format_ = surface_format.format;
             extent_ = extent;
+            present_mode_ = present_mode;
 
             create_info.oldSwapchain = old_swapchain_handle;
 
@@ -150,6 +147,7 @@ namespace vk
 
                 format_ = swapchain.format_;
                 extent_ = swapchain.extent_;
+                present_mode_ = swapchain.present_mode_;
 
                 p_logical_device_ = swapchain.p_logical_device_;
             }
@@ -193,20 +191,50 @@ namespace vk
             return available_formats[0];
         }
         VkPresentModeKHR
-        swapchain::choose_present_mode( std::vector<VkPresentModeKHR>& available_present_modes ) const
+        swapchain::choose_present_mode( std::vector<VkPresentModeKHR>& available_present_modes, present_policy policy ) const
         {
-            for( const auto& available_present_mode : available_present_modes )
-            {
+            auto is_available = [&available_present_modes]( VkPresentModeKHR present_mode ) {
+                return std::find( available_present_modes.begin(), available_present_modes.end(), present_mode ) != available_present_modes.end();
+            };
 
-                if( available_present_mode == VK_PRESENT_MODE_MAILBOX_KHR )
-                    return VK_PRESENT_MODE_MAILBOX_KHR;
-                else if( available_present_mode == VK_PRESENT_MODE_FIFO_KHR )
-                    return VK_PRESENT_MODE_FIFO_KHR;
-                else if( available_present_mode == VK_PRESENT_MODE_FIFO_RELAXED_KHR )
-                    return VK_PRESENT_MODE_FIFO_RELAXED_KHR;
+            switch( policy )
+            {
+                case present_policy::e_fifo_relaxed:
+                    if( is_available( VK_PRESENT_MODE_FIFO_RELAXED_KHR ) )
+                        return VK_PRESENT_MODE_FIFO_RELAXED_KHR;
+                    break;
+                case present_policy::e_mailbox:
+                    if( is_available( VK_PRESENT_MODE_MAILBOX_KHR ) )
+                        return VK_PRESENT_MODE_MAILBOX_KHR;
+                    break;
+                case present_policy::e_immediate:
+                    if( is_available( VK_PRESENT_MODE_IMMEDIATE_KHR ) )
+                        return VK_PRESENT_MODE_IMMEDIATE_KHR;
+                    break;
+                case present_policy::e_fastest_available:
+                    for( auto present_mode : { VK_PRESENT_MODE_IMMEDIATE_KHR, VK_PRESENT_MODE_MAILBOX_KHR, VK_PRESENT_MODE_FIFO_RELAXED_KHR } )
+                    {
+                        if( is_available( present_mode ) )
+                            return present_mode;
+                    }
+                    break;
+                case present_policy::e_fifo:
+                    break;
             }
 
-            return VK_PRESENT_MODE_IMMEDIATE_KHR;
+            return VK_PRESENT_MODE_FIFO_KHR;
+        }
+        uint32_t
+        swapchain::choose_image_count( const VkSurfaceCapabilitiesKHR& capabilities, uint32_t requested_count ) const
+        {
+            uint32_t image_count = requested_count > 0 ? requested_count : capabilities.minImageCount + 1;
+
+            image_count = std::max( image_count, capabilities.minImageCount );
+
+            if( capabilities.maxImageCount > 0 )
+                image_count = std::min( image_count, capabilities.maxImageCount );
+
+            return image_count;
         }
     }
 }
\ No newline at end of file
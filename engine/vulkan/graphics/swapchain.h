@@ -9,6 +9,7 @@
 
 #include "../core/physical_device.h"
 #include "../core/logical_device.h"
+#include "swapchain_settings.h"
 
 namespace vk
 {
@@ -19,7 +20,8 @@ namespace vk
         public:
             swapchain() = default;
             swapchain( const core::logical_device* p_logical_device, const core::physical_device& physical_device,
-                       const surface& surface, uint32_t width, uint32_t height, VkSwapchainKHR old_swapchain_handle = VK_NULL_HANDLE );
+                       const surface& surface, uint32_t width, uint32_t height, VkSwapchainKHR old_swapchain_handle = VK_NULL_HANDLE,
+                       const swapchain_settings& settings = { } );
             swapchain( const swapchain& swapchain ) = delete;
             swapchain( swapchain&& swapchain ) noexcept;
             ~swapchain( );
@@ -54,6 +56,10 @@ namespace vk
             {
                 return extent_;
             }
+            VkPresentModeKHR get_present_mode() const
+            {
+                return present_mode_;
+            }
 
             VkResult acquire_next_image( uint64_t timeout, VkSemaphore& semaphore_handle, VkFence fence_handle, uint32_t* p_image_index );
 
@@ -63,7 +69,8 @@ namespace vk
         private:
             VkExtent2D choose_extent_2d( VkSurfaceCapabilitiesKHR& capabilities, const uint32_t width, const uint32_t height ) const;
             VkSurfaceFormatKHR choose_surface_format( std::vector<VkSurfaceFormatKHR>& available_formats ) const;
-            VkPresentModeKHR choose_present_mode( std::vector<VkPresentModeKHR>& available_present_modes ) const;
+            VkPresentModeKHR choose_present_mode( std::vector<VkPresentModeKHR>& available_present_modes, present_policy policy ) const;
+            uint32_t choose_image_count( const VkSurfaceCapabilitiesKHR& capabilities, uint32_t requested_count ) const;
 
         private:
             const core::logical_device* p_logical_device_;
@@ -74,6 +81,7 @@ namespace vk
 
             VkFormat format_;
             VkExtent2D extent_;
+            VkPresentModeKHR present_mode_ = VK_PRESENT_MODE_FIFO_KHR;
 
             uint32_t image_count_;
         };
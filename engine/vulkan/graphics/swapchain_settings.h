@@ -0,0 +1,39 @@
+/*!
+ *
+ */
+
+#ifndef PROJEKT_SWAPCHAIN_SETTINGS_H
+#define PROJEKT_SWAPCHAIN_SETTINGS_H
+
+#include <cstdint>
+
+namespace vk
+{
+    namespace graphics
+    {
+        /*
+         * A mode the surface doesn't support falls back to FIFO, which every surface has.
+         * e_fastest_available prefers immediate, then mailbox, then FIFO relaxed.
+         */
+        enum class present_policy
+        {
+            e_fifo,
+            e_fifo_relaxed,
+            e_mailbox,
+            e_immediate,
+            e_fastest_available
+        };
+
+        struct swapchain_settings
+        {
+            present_policy policy = present_policy::e_mailbox;
+
+            /*
+             * 0 asks for one image more than the surface minimum, anything else is clamped to the surface limits.
+             */
+            uint32_t image_count = 0;
+        };
+    }
+}
+
+#endif //PROJEKT_SWAPCHAIN_SETTINGS_H
@@ -9,8 +9,11 @@ namespace vk
 {
     namespace graphics
     {
-        texture_image::texture_image( const core::logical_device& logical_device, const core::physical_device& physical_device,
-                                      const std::string& image_path )
+        texture_image::texture_image( const core::logical_device* p_logical_device, core::memory_allocator* p_memory_allocator,
+                                      core::upload_manager& upload_manager, const std::string& image_path )
+            :
+            p_logical_device_( p_logical_device ),
+            p_memory_allocator_( p_memory_allocator )
         {
             stbi_uc* pixels = stbi_load( image_path.c_str(), &width_, &height_, &channel_, STBI_rgb_alpha );
 
@@ -19,62 +22,82 @@ namespace vk
             if( !pixels )
                 throw exception{ "Failed to load texture image.", __FILE__, __LINE__ };
 
-            VkBuffer staging_buffer;
-            VkDeviceMemory staging_buffer_memory;
+            VkImageCreateInfo create_info = {};
+            create_info.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+            create_info.imageType = VK_IMAGE_TYPE_2D;
+            create_info.extent.width = static_cast<uint32_t>( width_ );
+            create_info.extent.height = static_cast<uint32_t>( height_ );
+            create_info.extent.depth = 1;
+            create_info.mipLevels = 1;
+            create_info.arrayLayers = 1;
+            create_info.format = VK_FORMAT_R8G8B8A8_UNORM;
+            create_info.tiling = VK_IMAGE_TILING_OPTIMAL;
+            create_info.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+            create_info.usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+            create_info.samples = VK_SAMPLE_COUNT_1_BIT;
+
+            const auto& queue_family_indices = upload_manager.get_queue_family_indices();
+            if( queue_family_indices.size() > 1 )
+            {
+                create_info.sharingMode = VK_SHARING_MODE_CONCURRENT;
+                create_info.queueFamilyIndexCount = static_cast<uint32_t>( queue_family_indices.size() );
+                create_info.pQueueFamilyIndices = queue_family_indices.data();
+            }
+            else
+            {
+                create_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+            }
 
-            create_buffer( logical_device, physical_device, image_size,
-                           VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                           VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-                           staging_buffer, staging_buffer_memory );
+            texture_image_handle_ = p_logical_device_->create_image( create_info );
+            texture_image_allocation_ = p_memory_allocator_->allocate_image_memory( texture_image_handle_, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT );
 
-            void* data;
-            logical_device.map_memory( staging_buffer_memory, 0, image_size, 0, &data );
-                memcpy( data, pixels, static_cast<size_t>( image_size ) );
-            logical_device.unmap_memory( staging_buffer_memory );
+            upload_ticket_ = upload_manager.upload_image( texture_image_handle_, pixels, image_size,
+                                                          create_info.extent.width, create_info.extent.height );
 
             stbi_image_free( pixels );
         }
-
-        void texture_image::create_buffer( const core::logical_device& logical_device,
-                                           const core::physical_device& physical_device, VkDeviceSize& size,
-                                           VkBufferUsageFlags&& usage, VkMemoryPropertyFlags&& properties,
-                                           VkBuffer& buffer, VkDeviceMemory& buffer_memory )
+        texture_image::texture_image( texture_image&& texture_image ) noexcept
+        {
+            *this = std::move( texture_image );
+        }
+        texture_image::~texture_image( )
         {
-            VkBufferCreateInfo create_info = {};
-            create_info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-            create_info.size = size;
-            create_info.usage = usage;
-            create_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+            if( texture_image_handle_ != VK_NULL_HANDLE )
+                texture_image_handle_ = p_logical_device_->destroy_image( texture_image_handle_ );
 
-            buffer = logical_device.create_buffer( create_info );
+            if( texture_image_allocation_.memory_handle != VK_NULL_HANDLE )
+                p_memory_allocator_->free( texture_image_allocation_ );
+        }
 
-            VkMemoryRequirements mem_reqs = logical_device.get_buffer_memory_requirements( buffer );
+        texture_image&
+        texture_image::operator=( texture_image&& texture_image ) noexcept
+        {
+            if( this != &texture_image )
+            {
+                if( texture_image_handle_ != VK_NULL_HANDLE )
+                    texture_image_handle_ = p_logical_device_->destroy_image( texture_image_handle_ );
 
-            VkMemoryAllocateInfo allocate_info = {};
-            allocate_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-            allocate_info.allocationSize = mem_reqs.size;
-            allocate_info.memoryTypeIndex = find_memory_type( physical_device, mem_reqs.memoryTypeBits, properties );
+                if( texture_image_allocation_.memory_handle != VK_NULL_HANDLE )
+                    p_memory_allocator_->free( texture_image_allocation_ );
 
-            buffer_memory = logical_device.allocate_memory( allocate_info );
+                texture_image_handle_ = texture_image.texture_image_handle_;
+                texture_image.texture_image_handle_ = VK_NULL_HANDLE;
 
-            VkDeviceSize offset = 0;
-            logical_device.bind_buffer_memory( buffer, buffer_memory, offset );
-        }
+                texture_image_allocation_ = texture_image.texture_image_allocation_;
+                texture_image.texture_image_allocation_ = {};
 
-        uint32_t texture_image::find_memory_type( const core::physical_device& physical_device, uint32_t type_filter,
-                                              VkMemoryPropertyFlags properties )
-        {
-            VkPhysicalDeviceMemoryProperties mem_properties = physical_device.get_memory_properties();
+                upload_ticket_ = texture_image.upload_ticket_;
+                texture_image.upload_ticket_ = 0;
 
-            for( uint32_t i = 0; i < mem_properties.memoryTypeCount; ++i )
-            {
-                if( ( type_filter & ( 1 << i ) ) && ( mem_properties.memoryTypes[i].propertyFlags & properties ) == properties )
-                {
-                    return i;
-                }
+                width_ = texture_image.width_;
+                height_ = texture_image.height_;
+                channel_ = texture_image.channel_;
+
+                p_logical_device_ = texture_image.p_logical_device_;
+                p_memory_allocator_ = texture_image.p_memory_allocator_;
             }
 
-            throw vulkan_exception{ "Failed to find a suitable memory type.", __FILE__, __LINE__ };
+            return *this;
         }
     }
-}
\ No newline at end of file
+}
@@ -11,6 +11,8 @@
 #include <stb/stb_image.h>
 
 #include "../core/logical_device.h"
+#include "../core/memory_allocator.h"
+#include "../core/upload_manager.h"
 
 #include "../../utils/exception/exception.h"
 
@@ -21,24 +23,38 @@ namespace vk
         class texture_image
         {
         public:
-            texture_image( const core::logical_device& logical_device, const core::physical_device& physical_device,
-                           const std::string& image_path );
+            texture_image( ) = default;
+            texture_image( const core::logical_device* p_logical_device, core::memory_allocator* p_memory_allocator,
+                           core::upload_manager& upload_manager, const std::string& image_path );
+            texture_image( const texture_image& texture_image ) = delete;
+            texture_image( texture_image&& texture_image ) noexcept;
+            ~texture_image( );
+
+            VkImage& get()
+            {
+                return texture_image_handle_;
+            }
+
+            core::upload_ticket get_upload_ticket() const
+            {
+                return upload_ticket_;
+            }
+
+            texture_image& operator=( const texture_image& texture_image ) = delete;
+            texture_image& operator=( texture_image&& texture_image ) noexcept;
 
         private:
-            void create_buffer( const core::logical_device& logical_device, const core::physical_device& physical_device,
-                                VkDeviceSize& size, VkBufferUsageFlags&& usage,
-                                VkMemoryPropertyFlags&& properties, VkBuffer& buffer,
-                                VkDeviceMemory& buffer_memory );
+            const core::logical_device* p_logical_device_ = nullptr;
+            core::memory_allocator* p_memory_allocator_ = nullptr;
 
-            uint32_t find_memory_type( const core::physical_device& physical_device, uint32_t type_filter, VkMemoryPropertyFlags properties );
-
-        private:
-            int width_;
-            int height_;
-            int channel_;
+            int width_ = 0;
+            int height_ = 0;
+            int channel_ = 0;
 
             VkImage texture_image_handle_ = VK_NULL_HANDLE;
-            VkDeviceMemory texture_image_memory_handle_ = VK_NULL_HANDLE;
+            helpers::memory_allocation texture_image_allocation_ = {};
+
+            core::upload_ticket upload_ticket_ = 0;
         };
     }
 }
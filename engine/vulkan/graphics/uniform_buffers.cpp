@@ -2,11 +2,10 @@
  *
  */
 
-#include <chrono>
+#include <algorithm>
 
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
-#include <cstring>
 
 #include "uniform_buffers.h"
 
@@ -18,44 +17,49 @@ namespace vk
     namespace graphics
     {
         uniform_buffers::uniform_buffers( const core::logical_device* p_logical_device,
+                                          core::memory_allocator* p_memory_allocator,
                                           const core::physical_device& physical_device,
-                                          uint32_t count )
+                                          VkDeviceSize frame_size, uint32_t frame_count )
             :
-            p_logical_device_( p_logical_device ),
-            count_( count )
+            alignment_( std::max<VkDeviceSize>( physical_device.get_properties().limits.minUniformBufferOffsetAlignment, 1 ) ),
+            frame_count_( frame_count )
         {
-            VkDeviceSize buffer_size = sizeof( uniform_buffer_object );
+            frame_size_ = ( frame_size + alignment_ - 1 ) / alignment_ * alignment_;
 
-            buffer_handles_ = new VkBuffer[count_];
-            memory_handles_ = new VkDeviceMemory[count_];
-
-            for( auto i = 0; i < count_; ++i )
-            {
-                create_buffer( physical_device, buffer_size,
-                               VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
-                               VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-                               buffer_handles_[i], memory_handles_[i] );
-            }
+            buffer_ = core::buffer( p_logical_device, p_memory_allocator, frame_size_ * frame_count_,
+                                    VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+                                    VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT );
         }
         uniform_buffers::uniform_buffers( uniform_buffers&& uniform_buffers ) noexcept
         {
             *this = std::move( uniform_buffers );
         }
 
-        uniform_buffers::~uniform_buffers( )
+        void
+        uniform_buffers::begin_frame( uint32_t frame_index )
         {
-            for( auto i = 0; i < count_; ++i )
-            {
-                if( buffer_handles_[i] != VK_NULL_HANDLE )
-                    buffer_handles_[i] = p_logical_device_->destroy_buffer( buffer_handles_[i] );
+            frame_begin_ = get_frame_offset( frame_index );
+            cursor_ = frame_begin_;
+        }
 
-                if( memory_handles_[i] != VK_NULL_HANDLE )
-                    memory_handles_[i] = p_logical_device_->free_memory( memory_handles_[i] );
-            }
+        uint32_t
+        uniform_buffers::allocate( VkDeviceSize size, void** pp_data )
+        {
+            auto offset = cursor_;
+            auto aligned_size = ( size + alignment_ - 1 ) / alignment_ * alignment_;
+
+            if( offset + aligned_size > frame_begin_ + frame_size_ )
+                throw vulkan_exception{ "Uniform buffer frame slice overflow.", __FILE__, __LINE__ };
+
+            cursor_ += aligned_size;
+
+            *pp_data = static_cast<char*>( buffer_.get_mapped_data() ) + offset;
+
+            return static_cast<uint32_t>( offset );
         }
 
-        void
-        uniform_buffers::update( glm::mat4& model_matrix, glm::mat4& view_matrix, glm::mat4& proj_matrix, uint32_t index )
+        uint32_t
+        uniform_buffers::update( glm::mat4& model_matrix, glm::mat4& view_matrix, glm::mat4& proj_matrix )
         {
             uniform_buffer_object ubo = {};
             ubo.model           = model_matrix;
@@ -63,17 +67,7 @@ namespace vk
             ubo.proj            = proj_matrix;
             ubo.proj[1][1]      *= -1;
 
-            VkDeviceSize offset = 0;
-            VkDeviceSize size = sizeof( ubo );
-            VkMemoryMapFlags flags = 0;
-
-            void* data;
-            p_logical_device_->map_memory( memory_handles_[index], offset, size, flags, &data );
-            {
-                memcpy( data, &ubo, sizeof( ubo ) );
-            }
-            p_logical_device_->unmap_memory( memory_handles_[index] );
-
+            return push( ubo );
         }
 
         uniform_buffers&
@@ -81,72 +75,18 @@ namespace vk
         {
             if( this != &uniform_buffers )
             {
-                for( auto i = 0; i < count_; ++i )
-                {
-                    if( buffer_handles_[i] != VK_NULL_HANDLE )
-                        buffer_handles_[i] = p_logical_device_->destroy_buffer( buffer_handles_[i] );
-
-                    if( memory_handles_[i] != VK_NULL_HANDLE )
-                        memory_handles_[i] = p_logical_device_->free_memory( memory_handles_[i] );
-                }
+                buffer_ = std::move( uniform_buffers.buffer_ );
 
-                count_ = uniform_buffers.count_;
-                uniform_buffers.count_ = 0;
+                alignment_ = uniform_buffers.alignment_;
+                frame_size_ = uniform_buffers.frame_size_;
+                frame_begin_ = uniform_buffers.frame_begin_;
+                cursor_ = uniform_buffers.cursor_;
 
-                buffer_handles_ = uniform_buffers.buffer_handles_;
-                uniform_buffers.buffer_handles_ = VK_NULL_HANDLE;
-
-                memory_handles_ = uniform_buffers.memory_handles_;
-                uniform_buffers.memory_handles_ = VK_NULL_HANDLE;
-
-                p_logical_device_ = uniform_buffers.p_logical_device_;
+                frame_count_ = uniform_buffers.frame_count_;
+                uniform_buffers.frame_count_ = 0;
             }
 
             return *this;
         }
-
-
-        void
-        uniform_buffers::create_buffer( const core::physical_device& physical_device, VkDeviceSize& size,
-                                        VkBufferUsageFlags usage, VkMemoryPropertyFlags properties,
-                                        VkBuffer& buffer, VkDeviceMemory& buffer_memory )
-        {
-            VkBufferCreateInfo create_info = {};
-            create_info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-            create_info.size = size;
-            create_info.usage = usage;
-            create_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-
-            buffer = p_logical_device_->create_buffer( create_info );
-
-            VkMemoryRequirements mem_reqs = p_logical_device_->get_buffer_memory_requirements( buffer );
-
-            VkMemoryAllocateInfo allocate_info = {};
-            allocate_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-            allocate_info.allocationSize = mem_reqs.size;
-            allocate_info.memoryTypeIndex = find_memory_type( physical_device, mem_reqs.memoryTypeBits, properties );
-
-            buffer_memory = p_logical_device_->allocate_memory( allocate_info );
-
-            VkDeviceSize offset = 0;
-            p_logical_device_->bind_buffer_memory( buffer, buffer_memory, offset );
-        }
-
-        uint32_t
-        uniform_buffers::find_memory_type( const core::physical_device& physical_device, uint32_t type_filter,
-                                           VkMemoryPropertyFlags properties )
-        {
-            VkPhysicalDeviceMemoryProperties mem_properties = physical_device.get_memory_properties();
-
-            for( uint32_t i = 0; i < mem_properties.memoryTypeCount; ++i )
-            {
-                if( ( type_filter & ( 1 << i ) ) && ( mem_properties.memoryTypes[i].propertyFlags & properties ) == properties )
-                {
-                    return i;
-                }
-            }
-
-            throw vulkan_exception{ "Failed to find a suitable memory type.", __FILE__, __LINE__ };
-        }
     }
-}
\ No newline at end of file
+}
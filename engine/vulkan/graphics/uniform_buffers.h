@@ -1,11 +1,16 @@
 /*!
- *
+ * @brief A persistently mapped ring of per-frame uniform slices. Data is
+ * written straight into the mapping and addressed through dynamic offsets.
  */
 
 #ifndef PROJEKT_UNIFORM_BUFFER_H
 #define PROJEKT_UNIFORM_BUFFER_H
 
+#include <cstring>
+
 #include "../core/logical_device.h"
+#include "../core/buffer.h"
+#include "../core/memory_allocator.h"
 
 namespace vk
 {
@@ -15,34 +20,51 @@ namespace vk
         {
         public:
             uniform_buffers( ) = default;
-            uniform_buffers( const core::logical_device* p_logical_device, const core::physical_device& physical_device, uint32_t count );
+            uniform_buffers( const core::logical_device* p_logical_device, core::memory_allocator* p_memory_allocator,
+                             const core::physical_device& physical_device, VkDeviceSize frame_size, uint32_t frame_count );
             uniform_buffers( const uniform_buffers& uniform_buffers ) = delete;
             uniform_buffers( uniform_buffers&& uniform_buffers ) noexcept;
-            ~uniform_buffers( );
+            ~uniform_buffers( ) = default;
+
+            void begin_frame( uint32_t frame_index );
 
-            void update( glm::mat4& model_matrix, glm::mat4& view_matrix, glm::mat4& proj_matrix, uint32_t index );
+            uint32_t allocate( VkDeviceSize size, void** pp_data );
 
-            const VkBuffer* get()
+            template<typename T>
+            uint32_t push( const T& data )
             {
-                return buffer_handles_;
+                void* p_data;
+                auto offset = allocate( sizeof( T ), &p_data );
+
+                memcpy( p_data, &data, sizeof( T ) );
+
+                return offset;
             }
 
-            uniform_buffers& operator=( const uniform_buffers& uniform_buffers ) = delete;
-            uniform_buffers& operator=( uniform_buffers&& uniform_buffers ) noexcept;
+            uint32_t update( glm::mat4& model_matrix, glm::mat4& view_matrix, glm::mat4& proj_matrix );
 
-        private:
-            void create_buffer( const core::physical_device& physical_device, VkDeviceSize& size, VkBufferUsageFlags usage,
-                                VkMemoryPropertyFlags properties, VkBuffer& buffer, VkDeviceMemory& buffer_memory );
+            VkBuffer& get()
+            {
+                return buffer_.get();
+            }
 
-            uint32_t find_memory_type( const core::physical_device& physical_device, uint32_t type_filter, VkMemoryPropertyFlags properties );
+            uint32_t get_frame_offset( uint32_t frame_index ) const
+            {
+                return static_cast<uint32_t>( frame_index * frame_size_ );
+            }
+
+            uniform_buffers& operator=( const uniform_buffers& uniform_buffers ) = delete;
+            uniform_buffers& operator=( uniform_buffers&& uniform_buffers ) noexcept;
 
         private:
-            const core::logical_device* p_logical_device_;
+            core::buffer buffer_;
 
-            VkBuffer* buffer_handles_ = VK_NULL_HANDLE;
-            VkDeviceMemory* memory_handles_ = VK_NULL_HANDLE;
+            VkDeviceSize alignment_ = 1;
+            VkDeviceSize frame_size_ = 0;
+            VkDeviceSize frame_begin_ = 0;
+            VkDeviceSize cursor_ = 0;
 
-            uint32_t count_ = 0;
+            uint32_t frame_count_ = 0;
         };
     }
 }
@@ -10,6 +10,8 @@
 #include <vulkan/vulkan.h>
 #include <glm/glm.hpp>
 
+#include "vertex_input_description.h"
+
 namespace vk
 {
     namespace graphics
@@ -48,6 +50,14 @@ namespace vk
 
                 return attribute_descriptions;
             };
+
+            static vertex_input_description
+            get_input_description()
+            {
+                auto attribute_descriptions = get_attribute_descriptions();
+
+                return { { get_binding_description() }, { attribute_descriptions.begin(), attribute_descriptions.end() } };
+            }
         };
     }
 }
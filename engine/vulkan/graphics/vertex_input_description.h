@@ -0,0 +1,24 @@
+/*!
+ *
+ */
+
+#ifndef PROJEKT_VERTEX_INPUT_DESCRIPTION_H
+#define PROJEKT_VERTEX_INPUT_DESCRIPTION_H
+
+#include <vector>
+
+#include <vulkan/vulkan.h>
+
+namespace vk
+{
+    namespace graphics
+    {
+        struct vertex_input_description
+        {
+            std::vector<VkVertexInputBindingDescription> bindings;
+            std::vector<VkVertexInputAttributeDescription> attributes;
+        };
+    }
+}
+
+#endif //PROJEKT_VERTEX_INPUT_DESCRIPTION_H
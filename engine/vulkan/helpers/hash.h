@@ -0,0 +1,24 @@
+/*!
+ *
+ */
+
+#ifndef PROJEKT_HASH_H
+#define PROJEKT_HASH_H
+
+#include <cstddef>
+#include <functional>
+
+namespace vk
+{
+    namespace helpers
+    {
+        template<typename T>
+        inline void
+        hash_combine( std::size_t& seed, const T& value )
+        {
+            seed ^= std::hash<T>{ }( value ) + 0x9e3779b9 + ( seed << 6 ) + ( seed >> 2 );
+        }
+    }
+}
+
+#endif //PROJEKT_HASH_H
@@ -0,0 +1,39 @@
+/*!
+ *
+ */
+
+#ifndef PROJEKT_MEMORY_ALLOCATION_H
+#define PROJEKT_MEMORY_ALLOCATION_H
+
+#include <vulkan/vulkan.h>
+
+namespace vk
+{
+    namespace helpers
+    {
+        struct memory_allocation
+        {
+            VkDeviceMemory memory_handle = VK_NULL_HANDLE;
+            VkDeviceSize offset = 0;
+            VkDeviceSize size = 0;
+
+            void* p_mapped_data = nullptr;
+
+            uint32_t memory_type_index = 0;
+            uint32_t block_index = 0;
+        };
+
+        struct memory_statistics
+        {
+            uint32_t block_count = 0;
+            uint32_t allocation_count = 0;
+
+            VkDeviceSize reserved_bytes = 0;
+            VkDeviceSize used_bytes = 0;
+
+            uint64_t device_allocation_count = 0;
+        };
+    }
+}
+
+#endif //PROJEKT_MEMORY_ALLOCATION_H
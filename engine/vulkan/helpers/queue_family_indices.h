@@ -15,7 +15,8 @@ namespace vk
         {
             e_graphics,
             e_present,
-            e_compute
+            e_compute,
+            e_transfer
         };
 
         struct queue_family_indices
@@ -23,6 +24,7 @@ namespace vk
             int32_t graphics_family = -1;
             int32_t present_family = -1;
             int32_t compute_family = -1;
+            int32_t transfer_family = -1;
 
             bool is_graphics_complete()
             {
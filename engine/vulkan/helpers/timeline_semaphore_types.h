@@ -0,0 +1,70 @@
+/*!
+ * @brief The VK_KHR_timeline_semaphore declarations the engine uses, for
+ * Vulkan headers older than the extension. Values and layouts are the
+ * ones from the registry, so the same binary runs against any driver
+ * exposing the extension. Newer headers are used as they are.
+ */
+
+#ifndef PROJEKT_TIMELINE_SEMAPHORE_TYPES_H
+#define PROJEKT_TIMELINE_SEMAPHORE_TYPES_H
+
+#include <vulkan/vulkan.h>
+
+#ifndef VK_KHR_timeline_semaphore
+#define VK_KHR_timeline_semaphore 1
+#define VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME "VK_KHR_timeline_semaphore"
+
+constexpr const VkStructureType VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES_KHR = static_cast<VkStructureType>( 1000207000 );
+constexpr const VkStructureType VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO_KHR = static_cast<VkStructureType>( 1000207002 );
+constexpr const VkStructureType VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO_KHR = static_cast<VkStructureType>( 1000207003 );
+constexpr const VkStructureType VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO_KHR = static_cast<VkStructureType>( 1000207004 );
+
+typedef enum VkSemaphoreTypeKHR
+{
+    VK_SEMAPHORE_TYPE_BINARY_KHR = 0,
+    VK_SEMAPHORE_TYPE_TIMELINE_KHR = 1,
+    VK_SEMAPHORE_TYPE_MAX_ENUM_KHR = 0x7FFFFFFF
+} VkSemaphoreTypeKHR;
+
+typedef VkFlags VkSemaphoreWaitFlagsKHR;
+
+typedef struct VkPhysicalDeviceTimelineSemaphoreFeaturesKHR
+{
+    VkStructureType sType;
+    void* pNext;
+    VkBool32 timelineSemaphore;
+} VkPhysicalDeviceTimelineSemaphoreFeaturesKHR;
+
+typedef struct VkSemaphoreTypeCreateInfoKHR
+{
+    VkStructureType sType;
+    const void* pNext;
+    VkSemaphoreTypeKHR semaphoreType;
+    uint64_t initialValue;
+} VkSemaphoreTypeCreateInfoKHR;
+
+typedef struct VkTimelineSemaphoreSubmitInfoKHR
+{
+    VkStructureType sType;
+    const void* pNext;
+    uint32_t waitSemaphoreValueCount;
+    const uint64_t* pWaitSemaphoreValues;
+    uint32_t signalSemaphoreValueCount;
+    const uint64_t* pSignalSemaphoreValues;
+} VkTimelineSemaphoreSubmitInfoKHR;
+
+typedef struct VkSemaphoreWaitInfoKHR
+{
+    VkStructureType sType;
+    const void* pNext;
+    VkSemaphoreWaitFlagsKHR flags;
+    uint32_t semaphoreCount;
+    const VkSemaphore* pSemaphores;
+    const uint64_t* pValues;
+} VkSemaphoreWaitInfoKHR;
+
+typedef VkResult ( VKAPI_PTR *PFN_vkWaitSemaphoresKHR )( VkDevice device, const VkSemaphoreWaitInfoKHR* pWaitInfo, uint64_t timeout );
+typedef VkResult ( VKAPI_PTR *PFN_vkGetSemaphoreCounterValueKHR )( VkDevice device, VkSemaphore semaphore, uint64_t* pValue );
+#endif
+
+#endif //PROJEKT_TIMELINE_SEMAPHORE_TYPES_H
@@ -1,46 +1,54 @@
 /*!
- *
+ * @brief Queues events from the window callbacks for the game loop. The
+ * queue is a fixed size ring with one producer, the thread polling the
+ * window, and one consumer, the thread pulling events, which may be
+ * different threads. Events pushed while the queue is full are dropped
+ * and counted.
  */
 
 #ifndef PROJEKT_EVENT_HANDLER_H
 #define PROJEKT_EVENT_HANDLER_H
 
+#include <cstdint>
 #include <vector>
 
 #include "event.h"
+#include "../../utils/containers/spsc_ring.h"
 
 class event_handler
 {
 public:
-    /*
-    static bool
-    pop_event( event& e )
+    static constexpr size_t EVENT_QUEUE_CAPACITY = 1024;
+
+public:
+    static bool pop_event( event& e )
     {
-        if( !event_queue_.empty() )
-        {
-            e = event_queue_.front();
-            event_queue_.;
+        return event_queue_.try_pop( e );
+    }
 
-            return true;
-        }
+    /*
+     * Replaces the contents of events with every queued event. Reusing the same vector, reserved
+     * to EVENT_QUEUE_CAPACITY, never allocates.
+     */
+    static void pull( std::vector<event>& events )
+    {
+        events.clear();
 
-        return false;
+        event_queue_.pop_all( [&events]( const event& e ) { events.push_back( e ); } );
     }
-     */
 
-    static std::vector<event> pull( )
+    static bool push_event( const event& e )
     {
-        return std::move( event_queue_ );
+        return event_queue_.try_push( e );
     }
 
-    static void
-    push_event( event& e )
+    static uint64_t get_dropped_count( )
     {
-        event_queue_.emplace_back( e );
+        return event_queue_.get_dropped_count();
     }
 
 private:
-    static std::vector<event> event_queue_;
+    static spsc_ring<event, EVENT_QUEUE_CAPACITY> event_queue_;
 };
 
 #endif //PROJEKT_EVENT_HANDLER_H
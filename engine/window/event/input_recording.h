@@ -0,0 +1,307 @@
+/*!
+ * @brief Records the event stream and the delta time of every frame to a
+ * compact binary file, and plays it back. A frame holds one batch of
+ * events for every time the game pulled events during it, so a replay
+ * hands out the same events at the same points in the frame.
+ *
+ * Layout, in native byte order: the magic and version, then per frame the
+ * delta time as a float, the batch count as a uint8, and per batch the
+ * event count as a uint16 followed by the events. An event is its type as
+ * a uint8 and only the payload that type uses.
+ */
+
+#ifndef PROJEKT_INPUT_RECORDING_H
+#define PROJEKT_INPUT_RECORDING_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "event.h"
+#include "../../utils/exception/exception.h"
+#include "../../utils/file_io/read.h"
+
+constexpr const uint32_t INPUT_RECORDING_MAGIC = 0x52494a50; // "PJIR" in little endian
+constexpr const uint32_t INPUT_RECORDING_VERSION = 1;
+
+class input_recorder
+{
+public:
+    explicit input_recorder( const std::string& filepath )
+        :
+        file_( filepath, std::ios::binary | std::ios::trunc )
+    {
+        if( !file_.good() )
+            throw exception{ "Error creating input recording: " + filepath + ".", __FILE__, __LINE__ };
+
+        write( INPUT_RECORDING_MAGIC );
+        write( INPUT_RECORDING_VERSION );
+    }
+    input_recorder( const input_recorder& input_recorder ) = delete;
+    ~input_recorder( )
+    {
+        flush_frame( );
+    }
+
+    input_recorder& operator=( const input_recorder& input_recorder ) = delete;
+
+    /*
+     * Starts a new frame simulated with delta_time, writing out the previous one.
+     */
+    void begin_frame( float delta_time )
+    {
+        flush_frame( );
+
+        frame_.clear();
+        batch_count_ = 0;
+        is_frame_open_ = true;
+
+        append( delta_time );
+        append( uint8_t{ 0 } );
+    }
+
+    /*
+     * One call per event pull, an empty batch still counts so the replay stays in step.
+     */
+    void record_events( const std::vector<event>& events )
+    {
+        if( !is_frame_open_ || batch_count_ == UINT8_MAX )
+            return;
+
+        ++batch_count_;
+
+        append( static_cast<uint16_t>( std::min<size_t>( events.size(), UINT16_MAX ) ) );
+
+        for( size_t i = 0; i < events.size() && i < UINT16_MAX; ++i )
+        {
+            const auto& e = events[i];
+
+            append( static_cast<uint8_t>( e.event_type ) );
+
+            switch( e.event_type )
+            {
+                case event::type::window_moved:
+                    append( e.window_move.x );
+                    append( e.window_move.y );
+                    break;
+                case event::type::window_resized:
+                    append( e.window_resize.width );
+                    append( e.window_resize.height );
+                    break;
+                case event::type::frame_buffer_resized:
+                    append( e.frame_buffer_resize.width );
+                    append( e.frame_buffer_resize.height );
+                    break;
+                case event::type::mouse_moved:
+                    append( e.mouse_move.x );
+                    append( e.mouse_move.y );
+                    break;
+                case event::type::mouse_button_pressed:
+                case event::type::mouse_button_released:
+                    append( e.mouse_button.button );
+                    break;
+                case event::type::key_pressed:
+                case event::type::key_released:
+                    append( e.key.key );
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+
+private:
+    template<typename T>
+    void write( const T& value )
+    {
+        file_.write( reinterpret_cast<const char*>( &value ), sizeof( T ) );
+    }
+
+    template<typename T>
+    void append( const T& value )
+    {
+        const auto offset = frame_.size();
+
+        frame_.resize( offset + sizeof( T ) );
+        std::memcpy( frame_.data() + offset, &value, sizeof( T ) );
+    }
+
+    void flush_frame( )
+    {
+        if( !is_frame_open_ )
+            return;
+
+        frame_[sizeof( float )] = static_cast<char>( batch_count_ );
+        file_.write( frame_.data(), frame_.size() );
+
+        is_frame_open_ = false;
+    }
+
+private:
+    std::ofstream file_;
+
+    std::vector<char> frame_;
+    uint8_t batch_count_ = 0;
+    bool is_frame_open_ = false;
+};
+
+class input_player
+{
+public:
+    /*
+     * The whole recording is read up front, so playback never touches the disk.
+     */
+    explicit input_player( const std::string& filepath )
+    {
+        const auto data = read_from_binary_file( filepath );
+        size_t offset = 0;
+
+        uint32_t magic = 0;
+        uint32_t version = 0;
+        if( !read( data, offset, magic ) || !read( data, offset, version ) ||
+            magic != INPUT_RECORDING_MAGIC || version != INPUT_RECORDING_VERSION )
+        {
+            throw exception{ "Not a supported input recording: " + filepath + ".", __FILE__, __LINE__ };
+        }
+
+        while( offset < data.size() )
+        {
+            frame f = {};
+            uint8_t batch_count = 0;
+
+            if( !read( data, offset, f.delta_time ) || !read( data, offset, batch_count ) )
+                throw exception{ "Truncated input recording: " + filepath + ".", __FILE__, __LINE__ };
+
+            f.batches.resize( batch_count );
+            for( auto& batch : f.batches )
+            {
+                if( !read_batch( data, offset, batch ) )
+                    throw exception{ "Truncated input recording: " + filepath + ".", __FILE__, __LINE__ };
+            }
+
+            frames_.emplace_back( std::move( f ) );
+        }
+    }
+
+    /*
+     * Moves on to the next recorded frame, false once all of them have been played.
+     */
+    bool next_frame( float& delta_time )
+    {
+        if( next_frame_ >= frames_.size() )
+            return false;
+
+        current_frame_ = next_frame_++;
+        next_batch_ = 0;
+
+        delta_time = frames_[current_frame_].delta_time;
+
+        return true;
+    }
+
+    /*
+     * The current frame's batches in recorded order, empty once they run out.
+     */
+    const std::vector<event>& next_batch( )
+    {
+        if( next_frame_ == 0 )
+            return empty_batch_;
+
+        const auto& batches = frames_[current_frame_].batches;
+        if( next_batch_ >= batches.size() )
+            return empty_batch_;
+
+        return batches[next_batch_++];
+    }
+
+    size_t get_frame_count( ) const
+    {
+        return frames_.size();
+    }
+
+    bool is_finished( ) const
+    {
+        return next_frame_ >= frames_.size();
+    }
+
+private:
+    struct frame
+    {
+        float delta_time;
+        std::vector<std::vector<event>> batches;
+    };
+
+    template<typename T>
+    static bool read( const std::string& data, size_t& offset, T& value )
+    {
+        if( data.size() - offset < sizeof( T ) )
+            return false;
+
+        std::memcpy( &value, data.data() + offset, sizeof( T ) );
+        offset += sizeof( T );
+
+        return true;
+    }
+
+    static bool read_batch( const std::string& data, size_t& offset, std::vector<event>& batch )
+    {
+        uint16_t event_count = 0;
+        if( !read( data, offset, event_count ) )
+            return false;
+
+        batch.resize( event_count );
+        for( auto& e : batch )
+        {
+            uint8_t type = 0;
+            if( !read( data, offset, type ) )
+                return false;
+
+            e.event_type = static_cast<event::type>( type );
+
+            bool is_complete = true;
+            switch( e.event_type )
+            {
+                case event::type::window_moved:
+                    is_complete = read( data, offset, e.window_move.x ) && read( data, offset, e.window_move.y );
+                    break;
+                case event::type::window_resized:
+                    is_complete = read( data, offset, e.window_resize.width ) && read( data, offset, e.window_resize.height );
+                    break;
+                case event::type::frame_buffer_resized:
+                    is_complete = read( data, offset, e.frame_buffer_resize.width ) && read( data, offset, e.frame_buffer_resize.height );
+                    break;
+                case event::type::mouse_moved:
+                    is_complete = read( data, offset, e.mouse_move.x ) && read( data, offset, e.mouse_move.y );
+                    break;
+                case event::type::mouse_button_pressed:
+                case event::type::mouse_button_released:
+                    is_complete = read( data, offset, e.mouse_button.button );
+                    break;
+                case event::type::key_pressed:
+                case event::type::key_released:
+                    is_complete = read( data, offset, e.key.key );
+                    break;
+                default:
+                    break;
+            }
+
+            if( !is_complete )
+                return false;
+        }
+
+        return true;
+    }
+
+private:
+    std::vector<frame> frames_;
+    const std::vector<event> empty_batch_;
+
+    size_t current_frame_ = 0;
+    size_t next_frame_ = 0;
+    size_t next_batch_ = 0;
+};
+
+#endif //PROJEKT_INPUT_RECORDING_H
@@ -10,7 +10,7 @@
 #include "../utils/exception/glfw_exception.h"
 #include "../utils/exception/vulkan_exception.h"
 
-std::vector<event> event_handler::event_queue_;
+spsc_ring<event, event_handler::EVENT_QUEUE_CAPACITY> event_handler::event_queue_;
 
 window::window( std::uint32_t width, std::uint32_t height, const std::string &title )
     :
@@ -98,6 +98,17 @@ window::get_height( ) const
     return height_;
 }
 
+VkExtent2D
+window::get_frame_buffer_extent( ) const
+{
+    int width = 0;
+    int height = 0;
+
+    glfwGetFramebufferSize( p_window_, &width, &height );
+
+    return { static_cast<std::uint32_t>( width ), static_cast<std::uint32_t>( height ) };
+}
+
 const std::string&
 window::get_title( ) const
 {
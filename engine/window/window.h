@@ -44,6 +44,11 @@ public:
     const std::uint32_t get_width() const;
     const std::uint32_t get_height() const;
 
+    /*
+     * In pixels, which differs from the window size in screen coordinates on high DPI displays.
+     */
+    VkExtent2D get_frame_buffer_extent() const;
+
     const std::string& get_title() const;
 
     void set_title( const std::string& title ) const
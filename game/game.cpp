@@ -3,20 +3,56 @@
  */
 
 #include <chrono>
+#include <cmath>
 #include <iostream>
 
 #include <glm/gtc/matrix_transform.hpp>
 
 #include "game.h"
+#include "../engine/utils/exception/exception.h"
 
-game::game( window& window )
+constexpr const char* TRACE_PATH = "trace.json";
+constexpr const char* PROFILE_PATH = "profile.json";
+constexpr const uint32_t TITLE_UPDATE_INTERVAL = 30;
+constexpr const uint32_t HEADLESS_WIDTH = 1280;
+constexpr const uint32_t HEADLESS_HEIGHT = 720;
+constexpr const float GPU_DRIVEN_SPACING = 0.25f;
+constexpr const float GPU_DRIVEN_SCALE = 0.1f;
+
+game::game( window* p_window, const game_settings& settings )
     :
-    window_( window ),
-    renderer_( window_ )
+    p_window_( p_window ),
+    settings_( settings ),
+    renderer_( p_window_ ? renderer( *p_window_, settings_.frames_in_flight, settings_.swapchain )
+                         : renderer( HEADLESS_WIDTH, HEADLESS_HEIGHT, settings_.frames_in_flight ) ),
+    frame_limiter_( settings_.target_fps )
 {
-    renderer_.create_pipeline( "../game/shaders/vert.spv" , "../game/shaders/frag.spv" );
+    if( !p_window_ && settings_.replay_path.empty() )
+        throw exception{ "A headless game needs a recording to replay.", __FILE__, __LINE__ };
+
+    if( !settings_.replay_path.empty() )
+        p_input_player_ = std::make_unique<input_player>( settings_.replay_path );
+
+    if( !settings_.record_path.empty() )
+        p_input_recorder_ = std::make_unique<input_recorder>( settings_.record_path );
+
+    events_.reserve( event_handler::EVENT_QUEUE_CAPACITY );
+
+    renderer_.create_pipeline( "shaders/vert.spv" , "shaders/frag.spv" );
 
     renderer_.prepare_for_rendering( vertices, indices_ );
+
+    if( settings_.gpu_driven_object_count > 0 )
+        prepare_gpu_driven_scene( );
+
+    renderer_.set_trace_writer( &trace_writer_ );
+
+    cpu_profiler::set_thread_name( "main" );
+    cpu_profiler::set_trace_writer( &trace_writer_ );
+}
+game::~game( )
+{
+    cpu_profiler::set_trace_writer( nullptr );
 }
 
 void
@@ -25,9 +61,10 @@ game::run( )
     auto time_point = std::chrono::steady_clock::now( );
     float max_dt = 1.0f / 20.0f;
 
-    while( window_.is_open( ) )
+    while( !p_window_ || p_window_->is_open( ) )
     {
-        window_.poll_event();
+        if( p_window_ )
+            p_window_->poll_event();
 
         float dt;
         {
@@ -37,58 +74,207 @@ game::run( )
         }
         dt = std::min( dt, max_dt );
 
-        time_passed += dt;
-        frames_passed += 1;
+        /*
+         * A replay steps the simulation by the recorded times, never by the wall clock.
+         */
+        if( p_input_player_ )
+        {
+            float recorded_dt;
+            if( !p_input_player_->next_frame( recorded_dt ) )
+                break;
+
+            dt = settings_.fixed_delta_time > 0.0f ? settings_.fixed_delta_time : recorded_dt;
+        }
+
+        if( p_input_recorder_ )
+            p_input_recorder_->begin_frame( dt );
 
-        if( time_passed >= 0.1 )
+        /*
+         * Tail latency rather than an average, a hitch every few seconds would vanish in the mean.
+         */
+        if( p_window_ && ++frame_count_ % TITLE_UPDATE_INTERVAL == 0 )
         {
-            window_.set_title( window_.get_title() + " : FPS - " + std::to_string( ( frames_passed / time_passed ) ) );
+            const auto frame_time = cpu_profiler::get_frame_percentiles( );
 
-            time_passed = 0;
-            frames_passed = 0;
+            p_window_->set_title( p_window_->get_title() + " : frame p50 " + std::to_string( frame_time.p50 )
+                               + " ms, p99 " + std::to_string( frame_time.p99 )
+                               + " ms, max " + std::to_string( frame_time.max )
+                               + " ms : GPU - " + std::to_string( renderer_.get_gpu_profiler().get_frame_time() ) + " ms" );
         }
 
-        auto events = event_handler::pull();
-        if( !events.empty() )
+        process_events( );
+
+        /*
+         * Simulation and the draw list for this frame are built while the GPU may still be busy
+         * with the frame that last used the same context.
+         */
+        {
+            cpu_profiler::zone zone( "update" );
+
+            update( dt );
+        }
         {
-            for( auto& e : events )
-            {
-                window_.handle_event( e );
-                renderer_.handle_event( e );
+            cpu_profiler::zone zone( "render" );
 
-                handle_input( e );
-            }
+            render( );
         }
 
         renderer_.prepare_frame( );
 
-        update( dt );
-        render( );
+        /*
+         * The wait above can be long, so input is sampled once more and the camera latched from it
+         * right before the image is acquired and the frame submitted.
+         */
+        if( p_window_ )
+            p_window_->poll_event();
+        process_events( );
+
+        latch_uniforms( );
 
         renderer_.submit_frame( );
+
+        {
+            cpu_profiler::zone zone( "frame limiter" );
+
+            frame_limiter_.wait( );
+        }
+
+        cpu_profiler::end_frame( );
+    }
+
+    if( p_input_player_ )
+    {
+        const auto frame_time = cpu_profiler::get_frame_percentiles( );
+
+        std::cout << "Replayed " << p_input_player_->get_frame_count() << " frames, frame time p50 " << frame_time.p50
+                  << " ms, p95 " << frame_time.p95 << " ms, p99 " << frame_time.p99 << " ms, max " << frame_time.max << " ms" << std::endl;
+
+        cpu_profiler::dump( settings_.replay_profile_path );
+    }
+}
+
+void
+game::process_events( )
+{
+    event_handler::pull( events_ );
+
+    /*
+     * While replaying, live events only keep the window and swapchain in step, the input comes from the recording.
+     */
+    for( auto& e : events_ )
+    {
+        if( p_window_ )
+            p_window_->handle_event( e );
+        renderer_.handle_event( e );
+
+        if( !p_input_player_ )
+            handle_input( e );
+    }
+
+    if( p_input_recorder_ )
+        p_input_recorder_->record_events( events_ );
+
+    if( p_input_player_ )
+    {
+        for( auto e : p_input_player_->next_batch() )
+            handle_input( e );
     }
 }
 
 void
 game::handle_input( event& e )
 {
+    if( e.event_type == event::type::key_pressed && e.key.key == io::keyboard::key::f1 )
+        toggle_trace_capture( );
+
+    if( e.event_type == event::type::key_pressed && e.key.key == io::keyboard::key::f2 )
+    {
+        cpu_profiler::dump( PROFILE_PATH );
+
+        std::cout << "Profile written to " << PROFILE_PATH << std::endl;
+    }
+}
+
+void
+game::toggle_trace_capture( )
+{
+    if( !trace_writer_.is_capturing() )
+    {
+        trace_writer_.begin_capture( );
 
+        return;
+    }
+
+    trace_writer_.end_capture( );
+    trace_writer_.write( TRACE_PATH );
+
+    std::cout << "Trace: " << trace_writer_.get_event_count() << " events written to " << TRACE_PATH << std::endl;
+    for( const auto& timing : renderer_.get_gpu_profiler().get_timings() )
+        std::cout << "  " << timing.name << ": " << timing.duration << " ms" << std::endl;
 }
 
 void
 game::update( float delta_time )
 {
     test += delta_time * 1.5f;
+}
+
+void
+game::latch_uniforms( )
+{
+    cpu_profiler::zone zone( "latch uniforms" );
 
     auto model_matrix = glm::rotate( glm::mat4( 1.0f ), test * glm::radians( 45.0f ), glm::vec3( 0.0f, 0.0f, 1.0f ) );
     auto view_matrix = glm::lookAt( glm::vec3( 0.0f, 0.0f, 5.0f ), glm::vec3( 0.0f, 0.0f, 0.0f ), glm::vec3( 0.0f, 1.0f, 0.0f ) );
-    auto projection_matrix = glm::perspective( glm::radians( 90.0f ), window_.get_width() / ( float ) window_.get_height(), 0.1f, 10.0f );
+    auto projection_matrix = glm::perspective( glm::radians( 90.0f ), get_aspect_ratio( ), 0.1f, 10.0f );
 
     renderer_.update( model_matrix, view_matrix, projection_matrix );
 }
+float
+game::get_aspect_ratio( ) const
+{
+    if( !p_window_ )
+        return HEADLESS_WIDTH / ( float ) HEADLESS_HEIGHT;
+
+    return p_window_->get_width() / ( float ) p_window_->get_height();
+}
+
+/*
+ * The grid is wider than the view, so the culling pass always has objects to reject.
+ */
+void
+game::prepare_gpu_driven_scene( )
+{
+    if( !renderer_.is_gpu_driven_supported( ) )
+        throw exception{ "The device can't render GPU driven, it lacks drawIndirectFirstInstance.", __FILE__, __LINE__ };
+
+    renderer_.prepare_gpu_driven_rendering( "shaders/indirect_vert.spv", "shaders/cull.spv",
+                                            settings_.gpu_driven_object_count );
+
+    const auto side = static_cast<uint32_t>( std::ceil( std::sqrt( static_cast<float>( settings_.gpu_driven_object_count ) ) ) );
+    const auto half_extent = ( side - 1 ) * GPU_DRIVEN_SPACING * 0.5f;
+
+    std::vector<vk::graphics::object_data> objects( settings_.gpu_driven_object_count );
+    for( uint32_t i = 0; i < settings_.gpu_driven_object_count; ++i )
+    {
+        const auto position = glm::vec3( ( i % side ) * GPU_DRIVEN_SPACING - half_extent, ( i / side ) * GPU_DRIVEN_SPACING - half_extent, 0.0f );
+
+        auto& object = objects[i];
+        object.model = glm::scale( glm::translate( glm::mat4( 1.0f ), position ), glm::vec3( GPU_DRIVEN_SCALE ) );
+        object.bounding_sphere = glm::vec4( 0.0f, 0.0f, 1.0f, std::sqrt( 2.0f ) );
+        object.index_count = static_cast<uint32_t>( indices_.size() );
+        object.first_index = 0;
+        object.vertex_offset = 0;
+    }
+
+    renderer_.set_objects( objects );
+}
 
 void
 game::render( )
 {
+    vk::graphics::draw_call draw_call = {};
+    draw_call.index_count = static_cast<uint32_t>( indices_.size() );
 
+    renderer_.draw( draw_call );
 }
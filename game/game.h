@@ -5,16 +5,62 @@
 #ifndef PROJEKT_GAME_H
 #define PROJEKT_GAME_H
 
+#include <memory>
+#include <string>
+
 #include "../engine/graphics/renderer.h"
+#include "../engine/utils/profiling/cpu_profiler.h"
+#include "../engine/utils/profiling/trace_writer.h"
+#include "../engine/utils/timing/frame_limiter.h"
 #include "../engine/window/window.h"
+#include "../engine/window/event/input_recording.h"
+
+struct game_settings
+{
+    /*
+     * Input and the delta time of every frame are written to record_path when it is set.
+     */
+    std::string record_path;
+
+    /*
+     * Plays back a recording instead of live input, the game exits once it runs out. The recorded
+     * delta times are used unless fixed_delta_time is set. A headless game needs a replay to run.
+     */
+    std::string replay_path;
+    float fixed_delta_time = 0.0f;
+
+    /*
+     * Where the CPU profiler's percentiles are dumped once a replay has finished.
+     */
+    std::string replay_profile_path = "replay_profile.json";
+
+    /*
+     * Ignored without a window.
+     */
+    vk::graphics::swapchain_settings swapchain;
+    uint32_t frames_in_flight = 2;
+
+    /*
+     * 0 leaves the frame rate uncapped, present mode permitting.
+     */
+    double target_fps = 0.0;
+
+    /*
+     * Draws a grid of this many objects through the GPU culling path on top of the quad, 0 turns it off.
+     */
+    uint32_t gpu_driven_object_count = 0;
+};
 
 class game
 {
 public:
-    explicit game( window& window );
+    /*
+     * Without a window the game renders offscreen.
+     */
+    game( window* p_window, const game_settings& settings );
     game( const game& ) = delete;
     game( game&& ) = delete;
-    ~game( ) = default;
+    ~game( );
 
     game& operator=( const game& ) = delete;
     game& operator=( game&& ) = delete;
@@ -22,22 +68,44 @@ public:
     void run();
 
 private:
+    void process_events( );
     void handle_input( event& e );
     void update( float delta_time );
     void render();
+    void latch_uniforms( );
+
+    float get_aspect_ratio( ) const;
+
+    void prepare_gpu_driven_scene( );
+
+    void toggle_trace_capture( );
 
 private:
-    window& window_;
+    window* p_window_;
+    game_settings settings_;
 
     vk::core::shader_module vertex_shader_;
     vk::core::shader_module fragment_shader_;
 
     renderer renderer_;
 
-    uint32_t frame_count_ = 0;
+    /*
+     * Caps the frame rate, and with it the power draw, at settings_.target_fps.
+     */
+    frame_limiter frame_limiter_;
 
-    float time_passed = 0;
-    int frames_passed = 0;
+    /*
+     * F1 starts and stops a capture, which is written to TRACE_PATH when stopped.
+     * F2 dumps the CPU profiler's percentiles and last frame to PROFILE_PATH.
+     */
+    trace_writer trace_writer_;
+
+    std::unique_ptr<input_recorder> p_input_recorder_;
+    std::unique_ptr<input_player> p_input_player_;
+
+    std::vector<event> events_;
+
+    uint32_t frame_count_ = 0;
 
     const std::vector<vk::graphics::vertex> vertices = {
             { { -1.0f, -1.0f,  1.0f }, { 1.0f, 0.0f, 0.0f } },
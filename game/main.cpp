@@ -1,4 +1,6 @@
 #include <iostream>
+#include <memory>
+#include <string>
 
 #include "../engine/utils/exception/exception.h"
 #include "../engine/utils/exception/vulkan_exception.h"
@@ -8,18 +10,86 @@
 
 #include "game.h"
 
-int main( )
+static vk::graphics::present_policy
+parse_present_policy( const std::string& mode )
+{
+    if( mode == "fifo" )
+        return vk::graphics::present_policy::e_fifo;
+    else if( mode == "fifo-relaxed" )
+        return vk::graphics::present_policy::e_fifo_relaxed;
+    else if( mode == "mailbox" )
+        return vk::graphics::present_policy::e_mailbox;
+    else if( mode == "immediate" )
+        return vk::graphics::present_policy::e_immediate;
+    else if( mode == "fastest" )
+        return vk::graphics::present_policy::e_fastest_available;
+
+    throw exception{ "Unknown present mode: " + mode + ".", __FILE__, __LINE__ };
+}
+
+/*
+ * --record file     records input and frame times to file
+ * --replay file     plays a recording back instead of live input
+ * --fixed-dt s      steps a replay by s seconds instead of the recorded times
+ * --headless        renders offscreen without a window, needs --replay
+ * --present mode    fifo, fifo-relaxed, mailbox, immediate or fastest
+ * --images n        swapchain image count, 0 for one more than the surface minimum
+ * --frames n        frames in flight, 1 to 4
+ * --fps-cap n       caps the frame rate at n, 0 for uncapped
+ * --gpu-driven n    draws a grid of n objects culled on the GPU
+ */
+static game_settings
+parse_settings( int argc, char** argv, bool& is_headless )
+{
+    game_settings settings;
+
+    for( int i = 1; i < argc; ++i )
+    {
+        const std::string arg = argv[i];
+        const bool has_value = i + 1 < argc;
+
+        if( arg == "--record" && has_value )
+            settings.record_path = argv[++i];
+        else if( arg == "--replay" && has_value )
+            settings.replay_path = argv[++i];
+        else if( arg == "--fixed-dt" && has_value )
+            settings.fixed_delta_time = std::stof( argv[++i] );
+        else if( arg == "--present" && has_value )
+            settings.swapchain.policy = parse_present_policy( argv[++i] );
+        else if( arg == "--images" && has_value )
+            settings.swapchain.image_count = static_cast<uint32_t>( std::stoul( argv[++i] ) );
+        else if( arg == "--frames" && has_value )
+            settings.frames_in_flight = static_cast<uint32_t>( std::stoul( argv[++i] ) );
+        else if( arg == "--fps-cap" && has_value )
+            settings.target_fps = std::stod( argv[++i] );
+        else if( arg == "--gpu-driven" && has_value )
+            settings.gpu_driven_object_count = static_cast<uint32_t>( std::stoul( argv[++i] ) );
+        else if( arg == "--headless" )
+            is_headless = true;
+        else
+            throw exception{ "Unknown or incomplete argument: " + arg + ".", __FILE__, __LINE__ };
+    }
+
+    return settings;
+}
+
+int main( int argc, char** argv )
 {
     std::string error_log_file = "error_log.txt";
     std::string error_warning = "Error has been found and logged in " + error_log_file;
 
     try
     {
-        window window( 100, 100, 1280, 720, "Project - Vulkan" );
+        bool is_headless = false;
+        const auto settings = parse_settings( argc, argv, is_headless );
+
+        std::unique_ptr<window> p_window;
+        if( !is_headless )
+            p_window = std::make_unique<window>( 100, 100, 1280, 720, "Project - Vulkan" );
 
         try
         {
-            game game( window );
+            game game( p_window.get(), settings );
             game.run();
         }
         catch( glfw_exception& e )
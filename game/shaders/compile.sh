@@ -1,2 +1,5 @@
 ~/VulkanSDK/1.1.73.0/x86_64/bin/glslangValidator -V shader.vert
 ~/VulkanSDK/1.1.73.0/x86_64/bin/glslangValidator -V shader.frag
+~/VulkanSDK/1.1.73.0/x86_64/bin/glslangValidator -V indirect.vert -o indirect_vert.spv
+~/VulkanSDK/1.1.73.0/x86_64/bin/glslangValidator -V cull.comp -o cull.spv
+~/VulkanSDK/1.1.73.0/x86_64/bin/glslangValidator -V instanced.vert -o instanced_vert.spv
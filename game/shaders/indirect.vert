@@ -0,0 +1,41 @@
+#version 450
+#extension GL_ARB_separate_shader_objects : enable
+
+layout( binding = 0 ) uniform UniformBufferObject
+{
+    mat4 model;
+    mat4 view;
+    mat4 proj;
+} ubo;
+
+struct object_data
+{
+    mat4 model;
+    vec4 bounding_sphere;
+    uint index_count;
+    uint first_index;
+    int vertex_offset;
+    uint padding;
+};
+
+layout( std430, binding = 1 ) readonly buffer ObjectBuffer
+{
+    object_data objects[];
+};
+
+layout( location = 0 ) in vec3 in_position;
+layout( location = 1 ) in vec3 in_colour;
+
+layout( location = 0 ) out vec3 frag_colour;
+
+
+out gl_PerVertex
+{
+    vec4 gl_Position;
+};
+
+void main()
+{
+    gl_Position = ubo.proj * ubo.view * objects[gl_InstanceIndex].model * vec4( in_position, 1.0 );
+    frag_colour = in_colour;
+}
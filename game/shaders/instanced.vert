@@ -0,0 +1,29 @@
+#version 450
+#extension GL_ARB_separate_shader_objects : enable
+
+layout( binding = 0 ) uniform UniformBufferObject
+{
+    mat4 model;
+    mat4 view;
+    mat4 proj;
+} ubo;
+
+layout( location = 0 ) in vec3 in_position;
+layout( location = 1 ) in vec3 in_colour;
+
+layout( location = 2 ) in mat4 in_instance_transform;
+layout( location = 6 ) in vec4 in_instance_colour;
+
+layout( location = 0 ) out vec3 frag_colour;
+
+
+out gl_PerVertex
+{
+    vec4 gl_Position;
+};
+
+void main()
+{
+    gl_Position = ubo.proj * ubo.view * in_instance_transform * vec4( in_position, 1.0 );
+    frag_colour = in_colour * in_instance_colour.rgb;
+}